@@ -0,0 +1,123 @@
+#include "AabbBatch.h"
+#include "BitOps.h"
+
+#if !defined(SPACEINVADERS_NO_SIMD) && defined(__AVX2__)
+#define AABB_KERNEL_AVX2 1
+#include <immintrin.h>
+#elif !defined(SPACEINVADERS_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#define AABB_KERNEL_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// Bits de [base, base + count) (count <= 64), sin filtrar por alive; escalar
+static uint64_t OverlapWordScalar(const SDL_FRect& r, const RectSoA& t, size_t base, size_t count) {
+    const float ax = r.x, ay = r.y, ax1 = r.x + r.w, ay1 = r.y + r.h;
+    uint64_t bits = 0;
+    for (size_t j = 0; j < count; ++j) {
+        const size_t i = base + j;
+        const bool hit = ax < t.x[i] + t.w[i] && ax1 > t.x[i] && ay < t.y[i] + t.h[i] && ay1 > t.y[i];
+        bits |= (uint64_t)hit << j;
+    }
+    return bits;
+}
+
+// Misma palabra con el kernel vectorial; la cola que no llena un registro va en escalar
+static uint64_t OverlapWord(const SDL_FRect& r, const RectSoA& t, size_t base, size_t count) {
+    uint64_t bits = 0;
+    size_t j = 0;
+#if defined(AABB_KERNEL_AVX2)
+    const __m256 ax = _mm256_set1_ps(r.x), ay = _mm256_set1_ps(r.y);
+    const __m256 ax1 = _mm256_set1_ps(r.x + r.w), ay1 = _mm256_set1_ps(r.y + r.h);
+    for (; j + 8 <= count; j += 8) {
+        const size_t i = base + j;
+        const __m256 bx = _mm256_loadu_ps(t.x + i), by = _mm256_loadu_ps(t.y + i);
+        const __m256 bw = _mm256_loadu_ps(t.w + i), bh = _mm256_loadu_ps(t.h + i);
+        __m256 m = _mm256_cmp_ps(ax, _mm256_add_ps(bx, bw), _CMP_LT_OQ);
+        m = _mm256_and_ps(m, _mm256_cmp_ps(ax1, bx, _CMP_GT_OQ));
+        m = _mm256_and_ps(m, _mm256_cmp_ps(ay, _mm256_add_ps(by, bh), _CMP_LT_OQ));
+        m = _mm256_and_ps(m, _mm256_cmp_ps(ay1, by, _CMP_GT_OQ));
+        bits |= (uint64_t)(unsigned)_mm256_movemask_ps(m) << j;
+    }
+#elif defined(AABB_KERNEL_SSE2)
+    const __m128 ax = _mm_set1_ps(r.x), ay = _mm_set1_ps(r.y);
+    const __m128 ax1 = _mm_set1_ps(r.x + r.w), ay1 = _mm_set1_ps(r.y + r.h);
+    for (; j + 4 <= count; j += 4) {
+        const size_t i = base + j;
+        const __m128 bx = _mm_loadu_ps(t.x + i), by = _mm_loadu_ps(t.y + i);
+        const __m128 bw = _mm_loadu_ps(t.w + i), bh = _mm_loadu_ps(t.h + i);
+        __m128 m = _mm_cmplt_ps(ax, _mm_add_ps(bx, bw));
+        m = _mm_and_ps(m, _mm_cmpgt_ps(ax1, bx));
+        m = _mm_and_ps(m, _mm_cmplt_ps(ay, _mm_add_ps(by, bh)));
+        m = _mm_and_ps(m, _mm_cmpgt_ps(ay1, by));
+        bits |= (uint64_t)(unsigned)_mm_movemask_ps(m) << j;
+    }
+#endif
+    if (j < count) bits |= OverlapWordScalar(r, t, base + j, count - j) << j;
+    return bits;
+}
+
+// Quitar los objetivos muertos (sólo mira los bits a 1, que suelen ser pocos)
+static uint64_t FilterAlive(uint64_t bits, const RectSoA& t, size_t base) {
+    if (!t.alive) return bits;
+    for (uint64_t b = bits; b; b &= b - 1) {
+        const int j = CountTrailingZeros64(b);
+        if (!t.alive[base + j]) bits &= ~(1ull << j);
+    }
+    return bits;
+}
+
+size_t OverlapMask(const SDL_FRect& r, const RectSoA& targets, uint64_t* mask) {
+    size_t hits = 0;
+    for (size_t base = 0, k = 0; base < targets.n; base += 64, ++k) {
+        const size_t count = targets.n - base < 64 ? targets.n - base : 64;
+        mask[k] = FilterAlive(OverlapWord(r, targets, base, count), targets, base);
+        hits += (size_t)PopCount64(mask[k]);
+    }
+    return hits;
+}
+
+size_t OverlapMaskScalar(const SDL_FRect& r, const RectSoA& targets, uint64_t* mask) {
+    size_t hits = 0;
+    for (size_t base = 0, k = 0; base < targets.n; base += 64, ++k) {
+        const size_t count = targets.n - base < 64 ? targets.n - base : 64;
+        mask[k] = FilterAlive(OverlapWordScalar(r, targets, base, count), targets, base);
+        hits += (size_t)PopCount64(mask[k]);
+    }
+    return hits;
+}
+
+size_t OverlapMatrix(const RectSoA& rects, const RectSoA& targets, uint64_t* masks) {
+    const size_t words = OverlapMaskWords(targets.n);
+    size_t hits = 0;
+    for (size_t k = 0; k < rects.n; ++k) {
+        uint64_t* row = masks + k * words;
+        if (rects.alive && !rects.alive[k]) {
+            for (size_t wi = 0; wi < words; ++wi) row[wi] = 0;
+            continue;
+        }
+        const SDL_FRect r = { rects.x[k], rects.y[k], rects.w[k], rects.h[k] };
+        hits += OverlapMask(r, targets, row);
+    }
+    return hits;
+}
+
+size_t FirstOverlap(const SDL_FRect& r, const RectSoA& targets, size_t from) {
+    for (size_t base = from & ~(size_t)63; base < targets.n; base += 64) {
+        const size_t count = targets.n - base < 64 ? targets.n - base : 64;
+        uint64_t bits = OverlapWord(r, targets, base, count);
+        if (base < from) bits &= ~0ull << (from - base);
+        bits = FilterAlive(bits, targets, base);
+        if (bits) return base + (size_t)CountTrailingZeros64(bits);
+    }
+    return targets.n;
+}
+
+const char* OverlapKernelName() {
+#if defined(AABB_KERNEL_AVX2)
+    return "avx2";
+#elif defined(AABB_KERNEL_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
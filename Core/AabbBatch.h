@@ -0,0 +1,52 @@
+#pragma once
+#include <SDL3/SDL_rect.h>
+#include <cstddef>
+#include <cstdint>
+
+// Solape de rectángulos (AABB) de uno contra muchos en lote.
+// Los objetivos van en SoA (x/y/w/h contiguos, como EnemyArray/BulletArray) y el kernel
+// prueba 8 (AVX2) o 4 (SSE2) a la vez; el resultado es una máscara de bits, un bit por
+// objetivo. Compara exactamente igual que RectsOverlap (mismas sumas en float, < y >
+// estrictos), así que cambiar de uno a otro no altera ninguna colisión.
+//
+// El kernel se elige al compilar: AVX2 si el build lleva -mavx2, si no SSE2 (siempre
+// disponible en x86-64), y escalar en otras arquitecturas o con -DSPACEINVADERS_NO_SIMD.
+
+// Solape de dos rects (bordes que sólo se tocan no cuentan)
+inline bool RectsOverlap(const SDL_FRect& a, const SDL_FRect& b) {
+    return (a.x < b.x + b.w &&
+            a.x + a.w > b.x &&
+            a.y < b.y + b.h &&
+            a.y + a.h > b.y);
+}
+
+// Rects en SoA. alive opcional: si no es nulo, los objetivos con alive[i] == 0 no solapan nunca
+struct RectSoA {
+    const float* x = nullptr;
+    const float* y = nullptr;
+    const float* w = nullptr;
+    const float* h = nullptr;
+    const uint8_t* alive = nullptr;
+    size_t n = 0;
+};
+
+// Palabras de 64 bits de una máscara para n objetivos
+inline size_t OverlapMaskWords(size_t n) { return (n + 63) / 64; }
+
+// Bit i de mask[i / 64] = r solapa el objetivo i. Escribe OverlapMaskWords(targets.n)
+// palabras y devuelve cuántos bits quedaron a 1.
+size_t OverlapMask(const SDL_FRect& r, const RectSoA& targets, uint64_t* mask);
+
+// Muchos contra muchos: fila k (OverlapMaskWords(targets.n) palabras a partir de
+// masks + k * OverlapMaskWords(targets.n)) = máscara del rect k de rects. Devuelve el total de pares.
+size_t OverlapMatrix(const RectSoA& rects, const RectSoA& targets, uint64_t* masks);
+
+// Índice del primer objetivo >= from que solapa r, o targets.n si ninguno. Recorre en
+// bloques de 64 y para en el primero con algún bit.
+size_t FirstOverlap(const SDL_FRect& r, const RectSoA& targets, size_t from = 0);
+
+// Kernel compilado: "avx2", "sse2" o "scalar"
+const char* OverlapKernelName();
+
+// Sólo para comparar en benchmarks: mismo contrato que OverlapMask, siempre escalar
+size_t OverlapMaskScalar(const SDL_FRect& r, const RectSoA& targets, uint64_t* mask);
@@ -0,0 +1,41 @@
+#include "AllocCounter.h"
+#include <cstdlib>
+#include <new>
+
+#ifndef SPACEINVADERS_NO_ALLOC_COUNTER
+
+static thread_local uint64_t tAllocations = 0;
+static thread_local uint64_t tBytes = 0;
+
+uint64_t AllocCounter::Allocations() { return tAllocations; }
+uint64_t AllocCounter::Bytes() { return tBytes; }
+
+static void* CountedAlloc(std::size_t size) {
+    ++tAllocations;
+    tBytes += size;
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new(std::size_t size) {
+    if (void* p = CountedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    if (void* p = CountedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return CountedAlloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return CountedAlloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+#else
+
+uint64_t AllocCounter::Allocations() { return 0; }
+uint64_t AllocCounter::Bytes() { return 0; }
+
+#endif
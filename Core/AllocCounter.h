@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+
+// Contador de reservas de memoria por hilo: AllocCounter.cpp reemplaza el operator new/delete
+// global y cuenta cada new en una variable thread_local (un incremento, sin atómicos), de modo
+// que varias partidas en paralelo (SimulationRunner) no se mezclan.
+// Game lo usa con --alloc-stats para comprobar que un paso en régimen estable no reserva nada.
+// Sólo ve lo que pasa por operator new (contenedores, strings, new de C++); los malloc de SDL
+// y de las librerías de C no cuentan.
+// Compilar con -DSPACEINVADERS_NO_ALLOC_COUNTER deja los operadores por defecto (todo a 0).
+namespace AllocCounter {
+    // Número de operator new y bytes pedidos en este hilo desde que arrancó
+    uint64_t Allocations();
+    uint64_t Bytes();
+}
+
+// Resumen de reservas por paso de simulación (--alloc-stats)
+struct AllocStats {
+    // Pasos iniciales de cada nivel que no cuentan como régimen estable (los arrays crecen
+    // hasta su tamaño de trabajo: partículas, observaciones de la IA...)
+    static constexpr int WarmupSteps = 120;
+
+    uint64_t steps = 0;
+    uint64_t steadySteps = 0;
+    uint64_t steadyStepsWithAllocs = 0; // pasos en régimen estable con alguna reserva
+    uint64_t allocations = 0;           // total (incluido calentamiento)
+    uint64_t steadyAllocations = 0;
+    uint64_t maxInStep = 0;
+    int stepsInLevel = 0;
+
+    void Record(uint64_t allocs) {
+        ++steps;
+        allocations += allocs;
+        if (allocs > maxInStep) maxInStep = allocs;
+        if (stepsInLevel++ < WarmupSteps) return;
+        ++steadySteps;
+        steadyAllocations += allocs;
+        if (allocs) ++steadyStepsWithAllocs;
+    }
+    void NewLevel() { stepsInLevel = 0; }
+};
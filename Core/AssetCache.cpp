@@ -0,0 +1,127 @@
+#include "AssetCache.h"
+#include <SDL3_image/SDL_image.h>
+#include "AssetPack.h"
+#include "Log.h"
+
+AssetCache& AssetCache::Get() {
+    static AssetCache cache;
+    return cache;
+}
+
+static void DestroyImage(const SDL_Surface* s) {
+    SDL_DestroySurface(const_cast<SDL_Surface*>(s));
+}
+
+// Toma posesión de loaded y la deja en RGBA32: quien lee los píxeles (edificios) no tiene
+// que convertir y la imagen compartida no se vuelve a tocar (ni blits que cacheen mapas en ella)
+static AssetCache::Image ToRGBA32(SDL_Surface* loaded, const std::string& path) {
+    if (loaded->format != SDL_PIXELFORMAT_RGBA32) {
+        SDL_Surface* conv = SDL_ConvertSurface(loaded, SDL_PIXELFORMAT_RGBA32);
+        SDL_DestroySurface(loaded);
+        if (!conv) {
+            LOG_WARN(Assets, "SDL_ConvertSurface failed for " << path << " : " << SDL_GetError());
+            return nullptr;
+        }
+        loaded = conv;
+    }
+    LOG_DEBUG(Assets, "Decoded " << path << " (" << loaded->w << "x" << loaded->h << ")");
+    return AssetCache::Image(loaded, DestroyImage);
+}
+
+AssetCache::Image AssetCache::Decode(const std::string& path) {
+    AssetPack::Item item;
+    if (AssetPack::Get().Find(path, item)) {
+        if (item.kind == AssetPack::Kind::Image && item.size >= (size_t)item.a * item.b * 4) {
+            // Ya en RGBA32 dentro del paquete: la surface apunta al mapeo, sin copiar ni
+            // decodificar (la imagen compartida nunca se escribe)
+            SDL_Surface* s = SDL_CreateSurfaceFrom((int)item.a, (int)item.b, SDL_PIXELFORMAT_RGBA32,
+                                                   const_cast<void*>(item.data), (int)item.a * 4);
+            if (s) {
+                LOG_DEBUG(Assets, path << " desde el paquete");
+                return Image(s, DestroyImage);
+            }
+        } else if (item.kind == AssetPack::Kind::Raw) {
+            // Imagen guardada tal cual: decodificar desde memoria
+            SDL_Surface* loaded = IMG_Load_IO(SDL_IOFromConstMem(item.data, item.size), true);
+            if (loaded) {
+                LOG_DEBUG(Assets, path << " desde el paquete");
+                return ToRGBA32(loaded, path);
+            }
+        }
+    }
+    SDL_Surface* loaded = IMG_Load(path.c_str());
+    if (!loaded) {
+        LOG_WARN(Assets, "IMG_Load failed for " << path << " : " << SDL_GetError());
+        return nullptr;
+    }
+    LOG_DEBUG(Assets, path << " desde fichero suelto");
+    return ToRGBA32(loaded, path);
+}
+
+AssetCache::Entry& AssetCache::EntryFor(const std::string& path) {
+    auto it = entries.find(path);
+    if (it != entries.end()) return it->second;
+    Entry& e = entries[path];
+    e.image = std::async(std::launch::async, &AssetCache::Decode, path).share();
+    return e;
+}
+
+void AssetCache::Preload(const std::vector<std::string>& paths) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const std::string& p : paths) EntryFor(p);
+}
+
+AssetCache::Image AssetCache::AcquireImage(const std::string& path) {
+    std::shared_future<Image> image;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        image = EntryFor(path).image;
+    }
+    // Esperar fuera del mutex: otros hilos pueden pedir imágenes ya listas mientras tanto
+    return image.get();
+}
+
+SDL_Texture* AssetCache::AcquireTexture(SDL_Renderer* renderer, const std::string& path) {
+    if (!renderer) return nullptr;
+    Image image = AcquireImage(path);
+    if (!image) return nullptr;
+    std::lock_guard<std::mutex> lock(mutex);
+    Entry& e = entries[path];
+    if (!e.texture) {
+        e.texture = SDL_CreateTextureFromSurface(renderer, const_cast<SDL_Surface*>(image.get()));
+        if (!e.texture) {
+            LOG_WARN(Assets, "SDL_CreateTextureFromSurface failed for " << path << " : " << SDL_GetError());
+            return nullptr;
+        }
+        e.textureRefs = 0;
+    }
+    ++e.textureRefs;
+    return e.texture;
+}
+
+void AssetCache::ReleaseTexture(SDL_Texture* texture) {
+    if (!texture) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& kv : entries) {
+        Entry& e = kv.second;
+        if (e.texture != texture) continue;
+        if (--e.textureRefs <= 0) {
+            SDL_DestroyTexture(e.texture);
+            e.texture = nullptr;
+            e.textureRefs = 0;
+        }
+        return;
+    }
+}
+
+void AssetCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& kv : entries) {
+        if (kv.second.texture) {
+            LOG_WARN(Assets, "Texture still referenced at Clear: " << kv.first);
+        }
+        // Esperar a las decodificaciones en curso antes de soltar sus futures
+        if (kv.second.image.valid()) kv.second.image.wait();
+    }
+    entries.clear();
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Caché de imágenes del proceso, por ruta. Cada fichero se decodifica una sola vez:
+//  - Preload lanza la decodificación (IMG_Load + conversión a RGBA32) en hilos de trabajo y
+//    vuelve enseguida; Game::Init la llama antes de crear la ventana. Si la imagen está en el
+//    AssetPack ya viene en RGBA32 y la surface apunta al mapeo (no hay nada que decodificar).
+//  - AcquireImage da la imagen decodificada, compartida y de sólo lectura (espera si aún se
+//    está decodificando). La usan los edificios, que copian sus píxeles a su surface mutable,
+//    también desde varias partidas a la vez (SimulationRunner).
+//  - AcquireTexture sube la imagen a textura la primera vez, en el hilo de render, y cuenta
+//    referencias: ReleaseTexture la destruye al llegar a 0. Una sola SDL_Renderer.
+class AssetCache {
+public:
+    using Image = std::shared_ptr<const SDL_Surface>;
+
+    static AssetCache& Get();
+
+    void Preload(const std::vector<std::string>& paths);
+    // nullptr si el fichero no existe o no se pudo decodificar
+    Image AcquireImage(const std::string& path);
+    SDL_Texture* AcquireTexture(SDL_Renderer* renderer, const std::string& path);
+    void ReleaseTexture(SDL_Texture* texture);
+
+    // Suelta todas las imágenes (antes de SDL_Quit). Las texturas ya deben estar liberadas.
+    void Clear();
+
+private:
+    AssetCache() = default;
+    struct Entry {
+        std::shared_future<Image> image;
+        SDL_Texture* texture = nullptr;
+        int textureRefs = 0;
+    };
+    // Entrada de path, lanzando su decodificación si no existía (con mutex tomado)
+    Entry& EntryFor(const std::string& path);
+    static Image Decode(const std::string& path);
+
+    std::mutex mutex;
+    std::unordered_map<std::string, Entry> entries;
+};
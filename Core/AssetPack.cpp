@@ -0,0 +1,147 @@
+#include "AssetPack.h"
+#include "Log.h"
+#include <cstring>
+#include <filesystem>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+constexpr char AssetPackFormat::kMagic[8];
+
+AssetPack& AssetPack::Get() {
+    static AssetPack pack;
+    return pack;
+}
+
+// Mapear el fichero entero de sólo lectura
+static const uint8_t* MapFile(const std::string& path, size_t& length, void*& mapping) {
+    length = 0;
+    mapping = nullptr;
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return nullptr;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) { CloseHandle(file); return nullptr; }
+    HANDLE map = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file); // el mapeo mantiene el fichero abierto
+    if (!map) return nullptr;
+    const void* view = MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0);
+    if (!view) { CloseHandle(map); return nullptr; }
+    length = (size_t)size.QuadPart;
+    mapping = map;
+    return (const uint8_t*)view;
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) { close(fd); return nullptr; }
+    void* view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) return nullptr;
+    length = (size_t)st.st_size;
+    return (const uint8_t*)view;
+#endif
+}
+
+static void UnmapFile(const uint8_t* view, size_t length, void* mapping) {
+#ifdef _WIN32
+    (void)length;
+    UnmapViewOfFile(view);
+    if (mapping) CloseHandle((HANDLE)mapping);
+#else
+    (void)mapping;
+    munmap((void*)view, length);
+#endif
+}
+
+bool AssetPack::Open(const std::string& path) {
+    Close();
+    const uint8_t* view = MapFile(path, length, mapping);
+    if (!view) return false;
+    base = view;
+
+    // Validar cabecera e índice antes de fiarse de ningún offset
+    AssetPackFormat::Header header;
+    bool ok = length >= sizeof(header);
+    if (ok) {
+        memcpy(&header, base, sizeof(header));
+        ok = memcmp(header.magic, AssetPackFormat::kMagic, sizeof(header.magic)) == 0 &&
+             header.version == AssetPackFormat::kVersion &&
+             (length - sizeof(header)) / sizeof(AssetPackFormat::Entry) >= header.entryCount;
+    }
+    if (ok) {
+        entries = (const AssetPackFormat::Entry*)(base + sizeof(header));
+        entryCount = header.entryCount;
+        for (uint32_t i = 0; i < entryCount && ok; ++i) {
+            const AssetPackFormat::Entry& e = entries[i];
+            ok = e.path[AssetPackFormat::kPathMax - 1] == '\0' && e.offset <= length && e.size <= length - e.offset;
+        }
+    }
+    if (!ok) {
+        LOG_WARN(Assets, "Asset pack no válido: " << path);
+        Close();
+        return false;
+    }
+    MarkStale(path);
+    LOG_INFO(Assets, "Asset pack " << path << ": " << entryCount << " entradas, " << (length >> 10) << " KB mapeados");
+    return true;
+}
+
+// Entradas cuyo fichero suelto se ha modificado después de generar el paquete: se leen sueltas
+void AssetPack::MarkStale(const std::string& path) {
+    namespace fs = std::filesystem;
+    stale.assign(entryCount, false);
+    std::error_code ec;
+    const auto packTime = fs::last_write_time(path, ec);
+    if (ec) return;
+    for (uint32_t i = 0; i < entryCount; ++i) {
+        const auto looseTime = fs::last_write_time(entries[i].path, ec);
+        if (ec || looseTime <= packTime) continue;
+        stale[i] = true;
+        LOG_WARN(Assets, entries[i].path << " es más reciente que " << path
+                 << ": se usa el fichero suelto (regenerar con tools/pack/build_packer.bat)");
+    }
+}
+
+void AssetPack::Close() {
+    if (base) UnmapFile(base, length, mapping);
+    base = nullptr;
+    length = 0;
+    entries = nullptr;
+    entryCount = 0;
+    stale.clear();
+    mapping = nullptr;
+}
+
+bool AssetPack::Find(const std::string& path, Item& out) const {
+    if (!base || path.empty() || path.size() >= AssetPackFormat::kPathMax) return false;
+    char key[AssetPackFormat::kPathMax];
+    for (size_t i = 0; i < path.size(); ++i) key[i] = path[i] == '\\' ? '/' : path[i];
+    key[path.size()] = '\0';
+    // Pocas decenas de entradas y se busca sólo al cargar: lineal
+    for (uint32_t i = 0; i < entryCount; ++i) {
+        const AssetPackFormat::Entry& e = entries[i];
+        if (strcmp(e.path, key) != 0) continue;
+        if (stale[i]) return false;
+        out.kind = e.kind;
+        out.data = base + e.offset;
+        out.size = (size_t)e.size;
+        out.a = e.a;
+        out.b = e.b;
+        return true;
+    }
+    return false;
+}
+
+SDL_IOStream* AssetPack::OpenIO(const std::string& path) const {
+    Item item;
+    if (!Find(path, item)) return nullptr;
+    return SDL_IOFromConstMem(item.data, item.size);
+}
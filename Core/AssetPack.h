@@ -0,0 +1,82 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Paquete de assets (assets.pack) generado offline por tools/pack/AssetPacker.
+// Un único fichero mapeado en memoria; cada entrada ya está en el formato que usa el juego:
+//  - Image: píxeles RGBA32 crudos (width x height, pitch width * 4), sin decodificar PNG/JPG
+//  - Sound: PCM float32 intercalado (channels, sampleRate), sin decodificar WAV
+//  - Levels: JSON de niveles compilado a MessagePack (nlohmann::json::from_msgpack)
+//  - Raw: el fichero tal cual (fuentes TTF), para abrirlo con SDL_IOFromConstMem
+// Las rutas son las mismas que se piden sueltas ("assets/base.png", "fonts/arial.ttf"...):
+// quien carga mira primero aquí y, si no está (o no hay paquete), lee el fichero del disco.
+// Una entrada cuyo fichero suelto es más reciente que el paquete se ignora (con aviso al
+// abrir), para que editar un PNG o Data/levels.json surta efecto aunque no se haya regenerado.
+//
+// Formato (little endian): PackHeader, entryCount PackEntry y los datos, cada bloque alineado
+// a 16 bytes. Se abre una vez al arrancar (Game::Init) y queda mapeado hasta salir: las
+// surfaces, fuentes y sonidos apuntan directamente a la memoria del mapeo.
+struct AssetPackFormat {
+    static constexpr char kMagic[8] = { 'S', 'I', 'P', 'A', 'C', 'K', '0', '1' };
+    static constexpr uint32_t kVersion = 1;
+    static constexpr size_t kPathMax = 112;
+    static constexpr uint64_t kAlign = 16;
+
+    enum class Kind : uint32_t { Raw = 0, Image = 1, Sound = 2, Levels = 3 };
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t entryCount;
+    };
+    struct Entry {
+        char path[kPathMax]; // terminada en 0, separador '/'
+        Kind kind;
+        uint32_t a;          // Image: width;  Sound: channels
+        uint32_t b;          // Image: height; Sound: sampleRate
+        uint32_t reserved;
+        uint64_t offset;     // desde el principio del fichero
+        uint64_t size;       // bytes
+    };
+};
+static_assert(sizeof(AssetPackFormat::Header) == 16, "AssetPack header layout");
+static_assert(sizeof(AssetPackFormat::Entry) == 144, "AssetPack entry layout");
+
+class AssetPack {
+public:
+    using Kind = AssetPackFormat::Kind;
+    struct Item {
+        Kind kind = Kind::Raw;
+        const void* data = nullptr;
+        size_t size = 0;
+        uint32_t a = 0, b = 0;
+    };
+
+    static AssetPack& Get();
+
+    // Mapea el paquete; false si no existe o no es válido (se sigue con ficheros sueltos).
+    // Llamar antes de que otros hilos lean assets: después sólo hay lecturas.
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const { return base != nullptr; }
+
+    // Entrada de path (con '/' o '\\'), o false (tampoco si está obsoleta)
+    bool Find(const std::string& path, Item& out) const;
+    // Stream de sólo lectura sobre la entrada, sin copiar (SDL_IOFromConstMem). nullptr si no está
+    SDL_IOStream* OpenIO(const std::string& path) const;
+
+private:
+    AssetPack() = default;
+    void MarkStale(const std::string& path);
+    ~AssetPack() { Close(); }
+
+    const uint8_t* base = nullptr;
+    size_t length = 0;
+    const AssetPackFormat::Entry* entries = nullptr;
+    uint32_t entryCount = 0;
+    std::vector<bool> stale; // por entrada: el fichero suelto es más nuevo que el paquete
+    void* mapping = nullptr; // HANDLE del mapeo en Windows
+};
@@ -1,6 +1,19 @@
+#include "AudioManagerMiniaudio.h"
+
+#ifdef SPACEINVADERS_SIM_ONLY
+// Build de simulación: no se compila miniaudio. Game nunca crea un AudioManagerMiniaudio
+// en este build, pero CollisionManager sigue referenciando la clase, así que dejamos no-ops.
+AudioManagerMiniaudio::AudioManagerMiniaudio() : pEngine(nullptr) {}
+AudioManagerMiniaudio::~AudioManagerMiniaudio() {}
+bool AudioManagerMiniaudio::Initialize() { return false; }
+void AudioManagerMiniaudio::Shutdown() {}
+bool AudioManagerMiniaudio::LoadSound(const std::string&, const std::string&) { return false; }
+void AudioManagerMiniaudio::PlaySoundManager(const std::string&, float) {}
+#else
 #define MINIAUDIO_IMPLEMENTATION
 #include "miniaudio.h"
-#include "AudioManagerMiniaudio.h"
+#include "AssetPack.h"
+#include "Log.h"
 #include <iostream>
 #include <vector>
 #include <cstring>
@@ -9,6 +22,8 @@
 struct AudioManagerMiniaudio::SoundData {
     ma_sound sound;
     ma_decoder decoder;
+    ma_audio_buffer buffer; // PCM del asset pack (fromPack), leído directamente del mapeo
+    bool fromPack = false;
     bool loaded = false;
 };
 
@@ -40,7 +55,8 @@ void AudioManagerMiniaudio::Shutdown() {
     for (auto& pair : sounds) {
         if (pair.second->loaded) {
             ma_sound_uninit(&pair.second->sound);
-            ma_decoder_uninit(&pair.second->decoder);
+            if (pair.second->fromPack) ma_audio_buffer_uninit(&pair.second->buffer);
+            else ma_decoder_uninit(&pair.second->decoder);
         }
         delete pair.second;
     }
@@ -55,13 +71,30 @@ void AudioManagerMiniaudio::Shutdown() {
 bool AudioManagerMiniaudio::LoadSound(const std::string& name, const std::string& filepath) {
     if (sounds.count(name)) return true;
     SoundData* data = new SoundData();
+    ma_engine* engine = (ma_engine*)pEngine;
+    AssetPack::Item item;
+    if (AssetPack::Get().Find(filepath, item) && item.kind == AssetPack::Kind::Sound && item.a > 0) {
+        // Ya decodificado a float32 por el packer: el buffer apunta al mapeo, sin copia
+        ma_audio_buffer_config cfg = ma_audio_buffer_config_init(ma_format_f32, item.a,
+            item.size / (sizeof(float) * item.a), item.data, NULL);
+        cfg.sampleRate = item.b;
+        if (ma_audio_buffer_init(&cfg, &data->buffer) == MA_SUCCESS) {
+            if (ma_sound_init_from_data_source(engine, &data->buffer, 0, NULL, &data->sound) == MA_SUCCESS) {
+                data->fromPack = true;
+                data->loaded = true;
+                sounds[name] = data;
+                LOG_DEBUG(Assets, filepath << " desde el paquete");
+                return true;
+            }
+            ma_audio_buffer_uninit(&data->buffer);
+        }
+    }
     ma_result result = ma_decoder_init_file(filepath.c_str(), NULL, &data->decoder);
     if (result != MA_SUCCESS) {
         std::cerr << "No se pudo cargar el sonido: " << filepath << std::endl;
         delete data;
         return false;
     }
-    ma_engine* engine = (ma_engine*)pEngine;
     result = ma_sound_init_from_data_source(engine, &data->decoder, 0, NULL, &data->sound);
     if (result != MA_SUCCESS) {
         std::cerr << "No se pudo inicializar el sonido: " << filepath << std::endl;
@@ -71,6 +104,7 @@ bool AudioManagerMiniaudio::LoadSound(const std::string& name, const std::string
     }
     data->loaded = true;
     sounds[name] = data;
+    LOG_DEBUG(Assets, filepath << " desde fichero suelto");
     return true;
 }
 // Nota: El nombre PlaySoundManager se usa para evitar conflicto con la macro PlaySound de windows.h
@@ -80,3 +114,4 @@ void AudioManagerMiniaudio::PlaySoundManager(const std::string& name, float volu
     ma_sound_set_volume(&it->second->sound, volume);
     ma_sound_start(&it->second->sound);
 }
+#endif
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+
+// Operaciones de bits sobre palabras de 64 bits (máscaras de edificios, solapes en lote).
+// GCC/Clang usan el builtin (popcnt/tzcnt si el build lo permite); el resto, la versión portable.
+
+inline int PopCount64(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(v);
+#else
+    v = v - ((v >> 1) & 0x5555555555555555ull);
+    v = (v & 0x3333333333333333ull) + ((v >> 2) & 0x3333333333333333ull);
+    v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return (int)((v * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+// Índice del bit a 1 más bajo (v != 0)
+inline int CountTrailingZeros64(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(v);
+#else
+    int n = 0;
+    while (!(v & 1u)) { v >>= 1; ++n; }
+    return n;
+#endif
+}
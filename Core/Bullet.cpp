@@ -1,83 +1,144 @@
 #include "Bullet.h"
-#include "EnemyManager.h"
 #include <cmath>
 
-Bullet::Bullet(float x, float y, float speed, float vx, bool isHoming, float tX, float tY, Owner owner, bool small) : speed(speed), vx(vx), isHoming(isHoming), targetX(tX), targetY(tY), owner(owner), smallForContinueFire(small) {
+BulletArray::BulletArray(uint32_t capacity)
+    : x(capacity), y(capacity), w(capacity), h(capacity),
+      prevX(capacity), prevY(capacity), vx(capacity), vy(capacity),
+      flags(capacity), owner(capacity), homing(capacity), slots(capacity) {
+}
+
+uint32_t BulletArray::Spawn(float x_, float y_, float speed, float vx_, bool isHoming, float tX, float tY, BulletOwner owner_, bool small) {
+    const uint32_t i = slots.Acquire();
+    if (i == SlotPool::Invalid) return i;
     // Default size for enemy bullets: 5x15, player bullets normally 5x15
     // If smallForContinueFire is true, use a slimmer/shorter bullet (e.g., 3x12)
-    if (smallForContinueFire) {
-        rect = { x, y, 3, 12 };
-    } else {
-        rect = { x, y, 5, 15 };
-    }
+    x[i] = x_;
+    y[i] = y_;
+    w[i] = small ? 3.0f : 5.0f;
+    h[i] = small ? 12.0f : 15.0f;
+    prevX[i] = x_;
+    prevY[i] = y_;
+    vx[i] = vx_;
+    vy[i] = speed;
+    flags[i] = (uint8_t)((isHoming ? Homing : 0) | (small ? Small : 0));
+    owner[i] = owner_;
+    BulletHoming hm;
+    hm.targetX = tX;
+    hm.targetY = tY;
     if (isHoming) {
-        homingLife = 300; // duración en frames de homing, ~5s a 60fps
-        if (targetX >= 0.0f && targetY >= 0.0f) hasTarget = true;
+        hm.life = 300; // duración en frames de homing, ~5s a 60fps
+        if (tX >= 0.0f && tY >= 0.0f) hm.hasTarget = true;
         // homing más lento que un misil normal
         // limitamos la velocidad vertical a un valor menor (velocidad es positiva hacia abajo o negativa hacia arriba)
     }
+    homing[i] = hm;
+    return i;
 }
 
-void Bullet::Update(float dt) {
+void BulletArray::UpdateHoming(uint32_t i) {
     // Homing behavior: ajustar vx para dirigirse al target sin invertir vy
-    if (isHoming && homingLife > 0) {
-        float bx = rect.x + rect.w / 2.0f;
-        float by = rect.y + rect.h / 2.0f;
-        float tx = targetX;
-        float ty = targetY;
-        // Si no tenemos target explícito, no hacemos nada agresivo
-        if (!hasTarget) {
-            // comportamiento por defecto antiguo: tirar ligeramente al centro
-            tx = 400.0f;
-            ty = 0.0f;
-        }
+    BulletHoming& hm = homing[i];
+    if (hm.life <= 0) return;
+    float bx = x[i] + w[i] / 2.0f;
+    float by = y[i] + h[i] / 2.0f;
+    float tx = hm.targetX;
+    float ty = hm.targetY;
+    // Si no tenemos target explícito, no hacemos nada agresivo
+    if (!hm.hasTarget) {
+        // comportamiento por defecto antiguo: tirar ligeramente al centro
+        tx = 400.0f;
+        ty = 0.0f;
+    }
 
-        float dx = tx - bx;
-        float dy = ty - by;
+    float dx = tx - bx;
+    float dy = ty - by;
 
-        // Calcular tiempo aproximado para alcanzar verticalmente, usando la velocidad vertical actual (speed)
-        float vy = speed; // note: speed puede ser negativo para disparos del jugador
-        float absVy = fabsf(vy);
-        if (absVy < 1.0f) absVy = 1.0f;
-        float t = fabsf(dy) / absVy;
-        if (t < 0.001f) t = 0.5f;
+    // Calcular tiempo aproximado para alcanzar verticalmente, usando la velocidad vertical actual
+    float absVy = fabsf(vy[i]); // note: vy puede ser negativo para disparos del jugador
+    if (absVy < 1.0f) absVy = 1.0f;
+    float t = fabsf(dy) / absVy;
+    if (t < 0.001f) t = 0.5f;
 
-        // Desired horizontal speed para alcanzar al target en tiempo t
-        float desiredVX = dx / t;
+    // Desired horizontal speed para alcanzar al target en tiempo t
+    float desiredVX = dx / t;
 
-        // Limitar para que no retroceda: no permitir desiredVX que haga que el misil invierta su dirección vertical
-        // En este contexto consideramos "no retroceder" como no invertir la componente vertical; ya que vy controla vertical,
-        // nos aseguramos de que el ajuste horizontal no haga cosas extrañas.
+    // Limitar velocidad horizontal a un máximo razonable (el ajuste horizontal no invierte vy)
+    if (desiredVX > hm.maxHorizSpeed) desiredVX = hm.maxHorizSpeed;
+    if (desiredVX < -hm.maxHorizSpeed) desiredVX = -hm.maxHorizSpeed;
 
-        // Limitar velocidad horizontal a un máximo razonable
-        if (desiredVX > maxHomingHorizSpeed) desiredVX = maxHomingHorizSpeed;
-        if (desiredVX < -maxHomingHorizSpeed) desiredVX = -maxHomingHorizSpeed;
+    // Aplicar un lerp suave para que el giro sea lento
+    vx[i] += (desiredVX - vx[i]) * hm.turnLerp;
 
-        // Aplicar un lerp suave para que el giro sea lento
-        vx += (desiredVX - vx) * homingTurnLerp;
+    hm.life--;
+}
 
-        homingLife--;
+void BulletArray::Update(float dt) {
+    const std::vector<uint32_t>& live = slots.Live();
+    // Guiado de misiles primero (sólo depende de la propia bala)
+    for (uint32_t i : live) {
+        if ((flags[i] & Homing) && slots.IsAlive(i)) UpdateHoming(i);
     }
+    // Mover usando vy (vertical) y vx (horizontal); fuera de pantalla -> inactiva
+    for (uint32_t i : live) {
+        if (!slots.IsAlive(i)) continue;
+        y[i] += vy[i] * dt;
+        x[i] += vx[i] * dt;
+        if (y[i] < 0 || y[i] > 600 || x[i] < 0 || x[i] > 800) slots.Release(i);
+    }
+}
 
-    // Mover usando speed (vertical) y vx (horizontal)
-    rect.y += speed * dt;
-    rect.x += vx * dt;
-    if (rect.y < 0 || rect.y > 600 || rect.x < 0 || rect.x > 800) active = false;
+void BulletArray::SavePrevRects() {
+    for (uint32_t i : slots.Live()) {
+        prevX[i] = x[i];
+        prevY[i] = y[i];
+    }
 }
 
-void Bullet::Render(SDL_Renderer* renderer) {
-    if (active) {
-        if (owner == Owner::Player) {
-            if (smallForContinueFire) {
+void BulletArray::Render(SpriteBatch& batch, float alpha) const {
+    for (uint32_t i : slots.Live()) {
+        if (!slots.IsAlive(i)) continue;
+        SDL_Color color;
+        if (owner[i] == BulletOwner::Player) {
+            if (flags[i] & Small) {
                 // Color #66cc99 (102,204,153)
-                SDL_SetRenderDrawColor(renderer, 102, 204, 153, 255);
+                color = {102, 204, 153, 255};
             } else {
-                SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+                color = {255, 255, 255, 255};
             }
         } else {
             // enemy bullets remain red
-            SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
+            color = {255, 0, 0, 255};
         }
-        SDL_RenderFillRect(renderer, &rect);
+        batch.FillRect(RenderRect(i, alpha), color);
+    }
+}
+
+void BulletArray::SaveState(StateWriter& wr) const {
+    uint32_t n = 0;
+    for (uint32_t i : slots.Live()) n += slots.IsAlive(i) ? 1 : 0;
+    wr.Put(n);
+    for (uint32_t i : slots.Live()) {
+        if (!slots.IsAlive(i)) continue;
+        wr.Put(x[i]); wr.Put(y[i]); wr.Put(w[i]); wr.Put(h[i]);
+        wr.Put(prevX[i]); wr.Put(prevY[i]);
+        wr.Put(vx[i]); wr.Put(vy[i]);
+        wr.Put(flags[i]); wr.Put(owner[i]);
+        wr.Put(homing[i]);
+    }
+}
+
+bool BulletArray::RestoreState(StateReader& r) {
+    uint32_t n = 0;
+    if (!r.Get(n) || n > slots.Capacity()) return false;
+    // Se vuelven a repartir los huecos desde el 0 conservando el orden de Live()
+    slots.Clear();
+    for (uint32_t k = 0; k < n; ++k) {
+        const uint32_t i = slots.Acquire();
+        r.Get(x[i]); r.Get(y[i]); r.Get(w[i]); r.Get(h[i]);
+        r.Get(prevX[i]); r.Get(prevY[i]);
+        r.Get(vx[i]); r.Get(vy[i]);
+        r.Get(flags[i]); r.Get(owner[i]);
+        r.Get(homing[i]);
     }
+    return r.Ok();
 }
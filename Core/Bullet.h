@@ -1,25 +1,81 @@
 #pragma once
-#include "Entity.h"
+#include <SDL3/SDL.h>
+#include <cstdint>
+#include <vector>
+#include "GameState.h"
+#include "Pool.h"
+#include "SpriteBatch.h"
 
-class Bullet : public Entity {
-public:
-    enum class Owner { Player, Enemy };
-    // targetX/targetY opcionales para misiles homing (si targetX >= 0 entonces se usa)
-    // smallForContinueFire -> indica que la bala es más pequeña y se colorea distinto (power-up ContinueFire)
-    Bullet(float x, float y, float speed, float vx = 0.0f, bool isHoming = false, float targetX = -1.0f, float targetY = -1.0f, Owner owner = Owner::Player, bool smallForContinueFire = false);
-    void Update(float dt) override;
-    void Render(SDL_Renderer* renderer) override;
-    bool active = true;
-    float speed;
-    float vx = 0.0f;
-    bool isHoming = false;
-    int homingLife = 0; // cuantos frames/actualizaciones mantiene comportamiento homing
+enum class BulletOwner : uint8_t { Player, Enemy };
+
+// Estado de guiado de un misil homing. Sólo lo leen las balas con BulletArray::Homing
+struct BulletHoming {
+    int life = 0; // cuantos frames/actualizaciones mantiene comportamiento homing
     // Target explícito para homing
     float targetX = -1.0f;
     float targetY = -1.0f;
     bool hasTarget = false;
-    float maxHomingHorizSpeed = 220.0f; // velocidad horizontal máxima del homing
-    float homingTurnLerp = 0.06f; // velocidad de corrección (menor = giro más lento)
-    Owner owner = Owner::Player;
-    bool smallForContinueFire = false;
+    float maxHorizSpeed = 220.0f; // velocidad horizontal máxima del homing
+    float turnLerp = 0.06f;       // velocidad de corrección (menor = giro más lento)
+};
+
+// Balas en formato SoA: un array por campo en lugar de un std::vector<Bullet> de objetos con
+// vtable. Update mueve todas las balas recorriendo x/y/vx/vy de forma contigua; el guiado
+// homing (raro) va aparte y sólo toca las balas marcadas.
+// Los arrays tienen capacidad fija y los huecos los reparte un SlotPool: Spawn/Kill son O(1),
+// una bala no cambia de índice mientras vive y disparar no reserva memoria. Los bucles
+// recorren Live() (huecos en orden de creación); las balas muertas siguen ahí, inactivas,
+// hasta RemoveInactive, que sólo compacta la lista de índices.
+class BulletArray {
+public:
+    enum Flags : uint8_t {
+        Homing = 1 << 0,
+        Small = 1 << 1 // bala más pequeña y verde del power-up ContinueFire
+    };
+    // Holgado: el jugador no pasa de ~60 balas en pantalla ni con ContinueFire
+    static constexpr uint32_t DefaultCapacity = 512;
+
+    explicit BulletArray(uint32_t capacity = DefaultCapacity);
+
+    // speed: velocidad vertical (negativa hacia arriba). targetX/targetY opcionales para
+    // misiles homing (si targetX >= 0 entonces se usa). Devuelve el hueco, o
+    // SlotPool::Invalid si el pool está lleno (la bala no se crea y cuenta en Rejected)
+    uint32_t Spawn(float x, float y, float speed, float vx = 0.0f, bool isHoming = false, float targetX = -1.0f, float targetY = -1.0f,
+                   BulletOwner owner = BulletOwner::Player, bool smallForContinueFire = false);
+    void Kill(uint32_t i) { slots.Release(i); }
+    bool IsActive(uint32_t i) const { return slots.IsAlive(i); }
+    void Update(float dt);
+    // Game::Step lo llama antes de mover (base de la interpolación)
+    void SavePrevRects();
+    void RemoveInactive() { slots.Compact(); }
+    void Clear() { slots.Clear(); }
+    // Huecos en uso en orden de creación (incluye los muertos de este paso: comprobar IsActive)
+    const std::vector<uint32_t>& Live() const { return slots.Live(); }
+    size_t Count() const { return slots.LiveCount(); }
+    uint32_t Capacity() const { return slots.Capacity(); }
+    // Disparos perdidos por pool lleno
+    uint64_t Rejected() const { return slots.Rejected(); }
+
+    SDL_FRect Rect(uint32_t i) const { return { x[i], y[i], w[i], h[i] }; }
+    SDL_FRect RenderRect(uint32_t i, float alpha) const {
+        return { prevX[i] + (x[i] - prevX[i]) * alpha, prevY[i] + (y[i] - prevY[i]) * alpha, w[i], h[i] };
+    }
+    void Render(SpriteBatch& batch, float alpha = 1.0f) const;
+
+    // Snapshot (Game::SaveState): las balas vivas en orden de Live()
+    void SaveState(StateWriter& wr) const;
+    bool RestoreState(StateReader& r);
+
+    // Caliente (indexado por hueco, tamaño Capacity())
+    std::vector<float> x, y, w, h;
+    std::vector<float> prevX, prevY;
+    std::vector<float> vx, vy;
+    std::vector<uint8_t> flags;
+    std::vector<BulletOwner> owner;
+    // Frío
+    std::vector<BulletHoming> homing;
+
+private:
+    SlotPool slots;
+    void UpdateHoming(uint32_t i);
 };
@@ -1,343 +1,471 @@
 #include "CollisionManager.h"
 #include "Game.h"
 #include "Skyscraper.h"
-#include <iostream>
-#include <chrono>
+#include "Log.h"
+#include "AabbBatch.h"
+#include "BitOps.h"
 
 CollisionManager::CollisionManager(AudioManagerMiniaudio* audio) : audioManager(audio) {
 }
 
-// Función auxiliar para detectar colisión entre dos rectángulos
-bool RectCollision(const SDL_FRect& a, const SDL_FRect& b) {
-    return (a.x < b.x + b.w &&
-            a.x + a.w > b.x &&
-            a.y < b.y + b.h &&
-            a.y + a.h > b.y);
-}
-
-void CollisionManager::CheckCollisions(Player& player, EnemyManager& enemies, std::vector<Bullet>& playerBullets, std::vector<Bullet>& enemyBullets, ParticleSystem& particles, Game& game, SDL_Renderer* renderer) {
+void CollisionManager::CheckCollisions(Player& player, EnemyManager& enemies, BulletArray& playerBullets, BulletArray& enemyBullets, ParticleSystem& particles, Game& game, SDL_Renderer* renderer) {
     // Integrar bloques defensivos (si existen)
     auto& blocks = enemies.defenseBlocks;
+    EnemyArray& foes = enemies.enemies;
+
+    // Colisiones: balas del jugador con enemigos (las balas del jugador atraviesan las defensas).
+    // Fase ancha: cada bala sólo prueba los enemigos de las celdas de la rejilla que toca
+    enemyGrid.Build(foes.x.data(), foes.y.data(), foes.w.data(), foes.h.data(), foes.alive.data(), foes.Size());
+    events.clear();
+    DetectPlayerBullets(foes, playerBullets, 0, playerBullets.Live().size(), candidates, events);
+    Resolve(player, enemies, playerBullets, enemyBullets, particles, game, renderer);
+
+    // Colisiones: balas enemigas con jugador y bloques defensivos
+    events.clear();
+    DetectEnemyBullets(blocks, player, enemyBullets, 0, enemyBullets.Live().size(), events);
+    Resolve(player, enemies, playerBullets, enemyBullets, particles, game, renderer);
+
+    // Colisiones: enemigos tocando bloques defensivos (destruyen bloque y enemigo)
+    events.clear();
+    DetectRams(foes, blocks, 0, foes.Size(), ramMasks, events);
+    Resolve(player, enemies, playerBullets, enemyBullets, particles, game, renderer);
+
+    // Detectar colisiones powerups con jugador
+    events.clear();
+    DetectPickups(player, game.GetPowerUps(), 0, game.GetPowerUps().Live().size(), events);
+    Resolve(player, enemies, playerBullets, enemyBullets, particles, game, renderer);
+
+    // Detectar enemigos que hayan cruzado la parte inferior de la ventana
+    events.clear();
+    DetectEscapes(foes, 0, foes.Size(), events);
+    Resolve(player, enemies, playerBullets, enemyBullets, particles, game, renderer);
+}
+
+uint32_t CollisionManager::FirstEnemyContact(const EnemyArray& foes, const SDL_FRect& r, uint32_t from, std::vector<uint32_t>& scratch) const {
+    // Candidatos en orden de índice como antes (el primero que toca se lleva el impacto)
+    enemyGrid.Query(r, scratch);
+    for (uint32_t i : scratch) {
+        if (i < from || !foes.alive[i]) continue;
+        if (RectsOverlap(r, foes.Rect(i))) return i;
+    }
+    return kNoTarget;
+}
 
-    // Colisiones: balas del jugador con enemigos
-    for (auto& bullet : playerBullets) {
-        if (!bullet.active) continue;
+void CollisionManager::DetectPlayerBullets(const EnemyArray& foes, const BulletArray& playerBullets, size_t begin, size_t end, std::vector<uint32_t>& scratch, std::vector<CollisionEvent>& out) const {
+    const std::vector<uint32_t>& live = playerBullets.Live();
+    for (size_t k = begin; k < end; ++k) {
+        const uint32_t b = live[k];
+        if (!playerBullets.IsActive(b)) continue;
+        const uint32_t i = FirstEnemyContact(foes, playerBullets.Rect(b), 0, scratch);
+        if (i == kNoTarget) continue;
+        CollisionEvent ev;
+        ev.kind = CollisionEvent::Kind::Hit;
+        ev.subject = b;
+        ev.target = i;
+        out.push_back(ev);
+    }
+}
 
-        bool bulletConsumed = false;
-        // Primero comprobar colisión con bloques defensivos (las balas del jugador atraviesan, así que ignorar)
-        for (auto& block : blocks) {
-            if (!block.alive) continue;
-            // balas del jugador atraviesan las defensas según requisito
+bool CollisionManager::EnemyBulletContact(const std::vector<Skyscraper>& blocks, const Player& player, const BulletArray& enemyBullets, uint32_t b, CollisionEvent& out) {
+    const SDL_FRect bulletRect = enemyBullets.Rect(b);
+    out.subject = b;
+    // Primero verificar colisión con edificios (skyscrapers)
+    for (size_t k = 0; k < blocks.size(); ++k) {
+        const Skyscraper& block = blocks[k];
+        if (!block.alive) continue;
+        if (RectsOverlap(bulletRect, block.rect)) {
+            // Check per-pixel opacity at bullet center so bullets pass through destroyed parts
+            float cx = bulletRect.x + bulletRect.w/2.0f;
+            float cy = bulletRect.y + bulletRect.h/2.0f;
+            if (block.IsOpaqueAtWorld(cx, cy)) {
+                out.kind = CollisionEvent::Kind::BuildingHit;
+                out.target = (uint32_t)k;
+                out.x = cx;
+                out.y = cy;
+                return true;
+            }
+            // If the pixel is transparent, the bullet passes through
         }
+    }
+    // Verificar colisión entre bala enemiga y jugador
+    if (RectsOverlap(bulletRect, player.rect)) {
+        out.kind = CollisionEvent::Kind::PlayerHit;
+        return true;
+    }
+    return false;
+}
 
-        for (auto& enemy : enemies.enemies) {
-            if (!enemy.alive) continue;
+void CollisionManager::DetectEnemyBullets(const std::vector<Skyscraper>& blocks, const Player& player, const BulletArray& enemyBullets, size_t begin, size_t end, std::vector<CollisionEvent>& out) const {
+    const std::vector<uint32_t>& live = enemyBullets.Live();
+    for (size_t k = begin; k < end; ++k) {
+        const uint32_t b = live[k];
+        if (!enemyBullets.IsActive(b)) continue;
+        CollisionEvent ev;
+        if (EnemyBulletContact(blocks, player, enemyBullets, b, ev)) out.push_back(ev);
+    }
+}
 
-            // Verificar colisión entre bala del jugador y enemigo
-            if (RectCollision(bullet.rect, enemy.rect)) {
+void CollisionManager::DetectRams(const EnemyArray& foes, const std::vector<Skyscraper>& blocks, size_t begin, size_t end, std::vector<uint64_t>& masks, std::vector<CollisionEvent>& out) const {
+    // Una máscara por edificio sobre los enemigos del tramo (kernel en lote); luego se recorren
+    // los enemigos que tocan alguno, en el mismo orden enemigo -> edificio de siempre
+    RectSoA rects = foes.Rects();
+    rects.x += begin;
+    rects.y += begin;
+    rects.w += begin;
+    rects.h += begin;
+    rects.alive += begin;
+    rects.n = end - begin;
+    const size_t words = OverlapMaskWords(rects.n);
+    masks.assign(blocks.size() * words, 0);
+    for (size_t k = 0; k < blocks.size(); ++k) {
+        if (blocks[k].alive) OverlapMask(blocks[k].rect, rects, &masks[k * words]);
+    }
+    for (size_t wi = 0; wi < words; ++wi) {
+        uint64_t any = 0;
+        for (size_t k = 0; k < blocks.size(); ++k) any |= masks[k * words + wi];
+        for (; any; any &= any - 1) {
+            const size_t bit = wi * 64 + (size_t)CountTrailingZeros64(any);
+            const size_t i = begin + bit;
+            const SDL_FRect er = foes.Rect(i);
+            for (size_t k = 0; k < blocks.size(); ++k) {
+                const Skyscraper& block = blocks[k];
+                if ((masks[k * words + wi] >> (bit & 63)) & 1u) {
+                    // enemy collides with skyscraper: compute contact point using intersection center
+                    SDL_FRect inter;
+                    inter.x = std::max(er.x, block.rect.x);
+                    inter.y = std::max(er.y, block.rect.y);
+                    inter.w = std::min(er.x + er.w, block.rect.x + block.rect.w) - inter.x;
+                    inter.h = std::min(er.y + er.h, block.rect.y + block.rect.h) - inter.y;
+
+                    CollisionEvent ev;
+                    ev.kind = CollisionEvent::Kind::Ram;
+                    ev.subject = (uint32_t)i;
+                    ev.target = (uint32_t)k;
+                    if (inter.w > 0.0f && inter.h > 0.0f) {
+                        ev.x = inter.x + inter.w / 2.0f;
+                        ev.y = inter.y + inter.h / 2.0f;
+                    } else {
+                        // fallback to enemy center if intersection degenerate
+                        ev.x = er.x + er.w / 2.0f;
+                        ev.y = er.y + er.h / 2.0f;
+                    }
+                    out.push_back(ev);
+                }
+            }
+        }
+    }
+}
+
+void CollisionManager::DetectPickups(const Player& player, const PowerUpPool& powerups, size_t begin, size_t end, std::vector<CollisionEvent>& out) const {
+    const std::vector<uint32_t>& live = powerups.Live();
+    for (size_t k = begin; k < end; ++k) {
+        const PowerUp& pu = powerups.At(live[k]);
+        if (!pu.active) continue;
+        if (RectsOverlap(pu.rect, player.rect)) {
+            CollisionEvent ev;
+            ev.kind = CollisionEvent::Kind::Pickup;
+            ev.subject = live[k];
+            out.push_back(ev);
+        }
+    }
+}
+
+void CollisionManager::DetectEscapes(const EnemyArray& foes, size_t begin, size_t end, std::vector<CollisionEvent>& out) const {
+    const float screenH = 600.0f;
+    for (size_t i = begin; i < end; ++i) {
+        if (!foes.alive[i]) continue;
+        if (foes.y[i] + foes.h[i] >= screenH) {
+            CollisionEvent ev;
+            ev.kind = CollisionEvent::Kind::Escape;
+            ev.subject = (uint32_t)i;
+            out.push_back(ev);
+        }
+    }
+}
+
+void CollisionManager::Resolve(Player& player, EnemyManager& enemies, BulletArray& playerBullets, BulletArray& enemyBullets, ParticleSystem& particles, Game& game, SDL_Renderer* renderer) {
+    auto& blocks = enemies.defenseBlocks;
+    EnemyArray& foes = enemies.enemies;
+
+    // Por índice: resolver un evento puede añadir otros al final (Drop)
+    for (size_t e = 0; e < events.size(); ++e) {
+        CollisionEvent ev = events[e];
+
+        // Un evento anterior de este paso puede haber cambiado lo que vio la detección: el
+        // enemigo ya murió o el impacto de otra bala vació el píxel. Entonces la bala sigue
+        // como antes: siguiente enemigo que toque / siguiente edificio o el jugador.
+        if (ev.kind == CollisionEvent::Kind::Hit && !foes.alive[ev.target]) {
+            ev.target = FirstEnemyContact(foes, playerBullets.Rect(ev.subject), ev.target + 1, candidates);
+            if (ev.target == kNoTarget) continue;
+        }
+        if (ev.kind == CollisionEvent::Kind::BuildingHit &&
+            !(blocks[ev.target].alive && blocks[ev.target].IsOpaqueAtWorld(ev.x, ev.y))) {
+            if (!EnemyBulletContact(blocks, player, enemyBullets, ev.subject, ev)) continue;
+        }
+
+        switch (ev.kind) {
+            case CollisionEvent::Kind::Hit: {
                 // ¡Impacto!
+                const uint32_t i = ev.target;
 
                 // Crear explosión de partículas en la posición del enemigo
-                float explosionX = enemy.rect.x + enemy.rect.w / 2;
-                float explosionY = enemy.rect.y + enemy.rect.h / 2;
-                particles.CreateExplosion(explosionX, explosionY, 12);
+                particles.CreateExplosion(foes.CenterX(i), foes.CenterY(i), 12);
 
                 // Reproducir sonido de explosión del enemigo
                 if (audioManager) {
                     audioManager->PlaySoundManager("enemy_explosion", 0.8f);
                 }
 
-                bullet.active = false;  // Destruir bala
+                playerBullets.Kill(ev.subject);  // Destruir bala
                 // Aplicar daño al enemigo y sólo ejecutar la lógica de muerte si realmente muere
-                enemy.TakeDamage(1);
-
-                if (enemy.IsAlive()) {
-                    // Enemigo aún vivo tras el impacto
-                    bulletConsumed = true;
-                    break;
-                }
+                foes.TakeDamage(i, 1);
+                if (!foes.alive[i]) KillEnemy(enemies, i, game);
+                break;
+            }
+            case CollisionEvent::Kind::Drop:
+                RollDrop(game, ev.x, ev.y);
+                break;
+            case CollisionEvent::Kind::BuildingHit: {
+                int radius = 18; // radio de daño en px (ajustado a 18)
+                LOG_DEBUG(Collision, "Enemy bullet hit skyscraper at " << ev.x << "," << ev.y);
+                blocks[ev.target].TakeBulletHit(ev.x, ev.y, radius);
+                // La zona dañada se sube a la textura en el Render de este frame, junto
+                // con el resto de impactos
+                enemyBullets.Kill(ev.subject);
+                particles.CreateExplosion(ev.x, ev.y, 8);
+                break;
+            }
+            case CollisionEvent::Kind::PlayerHit: {
+                // ¡El jugador fue impactado!
 
-                // Notificar al juego de la muerte (reglas de drop por nivel)
-                // NOTE: la lógica de spawn por regla se consultará más abajo y devolverá
-                // un booleano indicando si ya generó un power-up.
-
-                // Si el enemigo era splitter, spawnear dos básicos en posiciones libres cercanas
-                if (enemy.isSplitter || enemy.type == EnemyType::Splitter) {
-                    // Determinar HP y velocidad para los hijos
-                    int childHp = enemy.maxHealth / 2;
-                    if (childHp < 1) childHp = 1;
-                    float childSpeed = enemy.speed * 1.5f;
-
-                    // Intentar colocar a la izquierda y derecha evitando solapamientos
-                    float leftX = enemy.rect.x - enemy.rect.w - 8.0f;
-                    float rightX = enemy.rect.x + enemy.rect.w + 8.0f;
-                    float childY = enemy.rect.y;
-
-                    auto isFree = [&](float x, float y) {
-                        SDL_FRect r = { x, y, enemy.rect.w, enemy.rect.h };
-                        for (auto& other : enemies.enemies) {
-                            if (!other.alive) continue;
-                            if (r.x < other.rect.x + other.rect.w && r.x + r.w > other.rect.x && r.y < other.rect.y + other.rect.h && r.y + r.h > other.rect.y)
-                                return false;
-                        }
-                        return true;
-                    };
-
-                    // Ajustar límites de pantalla
-                    const float screenW = 800.0f;
-                    if (leftX < 0.0f) leftX = 8.0f;
-                    if (rightX + enemy.rect.w > screenW) rightX = screenW - enemy.rect.w - 8.0f;
-
-                    // Crear hijos si hay hueco, si no, buscar pequeñas correcciones
-                    if (isFree(leftX, childY)) {
-                        enemies.enemies.emplace_back(leftX, childY, childHp, EnemyColor(255,0,0,255), EnemyType::Basic, childSpeed, enemy.damage, MovePattern::Straight);
-                    } else {
-                        // buscar desplazamiento hacia la izquierda
-                        for (int off = 16; off <= 160; off += 16) {
-                            if (leftX - off >= 0 && isFree(leftX - off, childY)) {
-                                enemies.enemies.emplace_back(leftX - off, childY, childHp, EnemyColor(255,0,0,255), EnemyType::Basic, childSpeed, enemy.damage, MovePattern::Straight);
-                                break;
-                            }
-                        }
-                    }
+                // Crear explosión de partículas en la posición del jugador
+                float explosionX = player.rect.x + player.rect.w / 2;
+                float explosionY = player.rect.y + player.rect.h / 2;
+                particles.CreateExplosion(explosionX, explosionY, 8);
 
-                    if (isFree(rightX, childY)) {
-                        enemies.enemies.emplace_back(rightX, childY, childHp, EnemyColor(255,0,0,255), EnemyType::Basic, childSpeed, enemy.damage, MovePattern::Straight);
-                    } else {
-                        // buscar desplazamiento hacia la derecha
-                        for (int off = 16; off <= 160; off += 16) {
-                            if (rightX + off + enemy.rect.w <= screenW && isFree(rightX + off, childY)) {
-                                enemies.enemies.emplace_back(rightX + off, childY, childHp, EnemyColor(255,0,0,255), EnemyType::Basic, childSpeed, enemy.damage, MovePattern::Straight);
-                                break;
-                            }
-                        }
-                    }
+                // Reproducir sonido de muerte del jugador
+                if (audioManager) {
+                    audioManager->PlaySoundManager("player_death", 0.9f);
                 }
 
-                // Posibilidad de dropear powerup al morir (10%) o forzar en modo test
-                // Pero si Game::OnEnemyKilled() ya spawnó un powerup (regla de nivel 1), saltar esta lógica.
-                // Pasar la posición del enemigo para que el powerup forzado aparezca ahí
-                bool spawnedByRule = game.OnEnemyKilled(enemy.rect.x + enemy.rect.w/2, enemy.rect.y + enemy.rect.h/2);
-                if (spawnedByRule) {
-                    // Ya se ha generado un powerup por la regla de nivel, no generar más
-                } else {
-                    bool forced = game.IsPowerupTestMode();
-                    int baseChance = forced ? 100 : 8; // probabilidad base
-                    // Darle un pequeño bonus en Nivel 2 (índice 1) para equilibrar drops
-                    if (!forced && game.GetCurrentLevel() == 1) baseChance = 12;
-                    if (rand() % 100 < baseChance) {
-                        // Elegir tipo aleatorio de powerup
-                        static int testIndex = 0;
-                        PowerUp::Type chosen = PowerUp::Type::RestoreDefense;
-                        if (forced) {
-                            // En modo test, ciclar por tipos para poder probarlos todos
-                            int idx = testIndex++;
-                            switch (idx % 6) {
-                                case 0: chosen = PowerUp::Type::RestoreDefense; break;
-                                case 1: chosen = PowerUp::Type::BulletTime; break;
-                                case 2: chosen = PowerUp::Type::ExtraLife; break;
-                                case 3: chosen = PowerUp::Type::HomingMissiles; break;
-                                case 4: chosen = PowerUp::Type::Shield; break;
-                                case 5: chosen = PowerUp::Type::ContinueFire; break;
-                            }
-                        } else {
-                            int r = rand() % 6;
-                            switch (r) {
-                                case 0: chosen = PowerUp::Type::RestoreDefense; break;
-                                case 1: chosen = PowerUp::Type::BulletTime; break;
-                                case 2: chosen = PowerUp::Type::ExtraLife; break;
-                                case 3: chosen = PowerUp::Type::HomingMissiles; break;
-                                case 4: chosen = PowerUp::Type::Shield; break;
-                                case 5: chosen = PowerUp::Type::ContinueFire; break;
-                            }
-                        }
-
-                        // Spawn powerup en la posición del enemigo
-                        PowerUp pu(enemy.rect.x + enemy.rect.w/2 - 9.0f, enemy.rect.y + enemy.rect.h/2, chosen);
-                        game.SpawnPowerUp(pu);
-                        std::cout << "[CollisionManager] PowerUp spawned (" << (int)chosen << ") at " << pu.rect.x << "," << pu.rect.y << std::endl;
-                    }
-                }
+                enemyBullets.Kill(ev.subject);  // Destruir bala
 
-                // Sumar puntos
-                game.AddScore(10);
+                // El jugador pierde una vida
+                game.LoseLife();
 
-                std::cout << "¡Enemigo destruido con explosión! +10 puntos" << std::endl;
-                bulletConsumed = true;
-                break; // La bala ya impactó, no necesita seguir verificando
+                LOG_INFO(Collision, "¡Jugador impactado! Vidas restantes: " << game.GetLives());
+                break;
+            }
+            case CollisionEvent::Kind::Ram: {
+                // Un edificio destruido por un choque anterior de este paso ya no cuenta
+                Skyscraper& block = blocks[ev.target];
+                if (!block.alive) break;
+                int impactRadius = 18; // use same radius as bullet impacts for consistency
+                LOG_DEBUG(Collision, "Enemy collided with skyscraper at " << ev.x << "," << ev.y);
+                block.TakeBulletHit(ev.x, ev.y, impactRadius);
+                // enemy is destroyed on impact
+                foes.alive[ev.subject] = 0;
+                enemies.OnEnemyDied(ev.subject);
+                particles.CreateExplosion(ev.x, ev.y, 10);
+                if (audioManager) audioManager->PlaySoundManager("enemy_explosion", 0.8f);
+                break;
+            }
+            case CollisionEvent::Kind::Pickup:
+                ApplyPickup(game.GetPowerUps().At(ev.subject), blocks, game, renderer);
+                break;
+            case CollisionEvent::Kind::Escape: {
+                const uint32_t i = ev.subject;
+                // El enemigo ha escapado
+                foes.alive[i] = 0; // eliminar enemigo
+                enemies.OnEnemyDied(i);
+
+                // Crear explosión en su posición
+                particles.CreateExplosion(foes.CenterX(i), foes.CenterY(i), 12);
+                if (audioManager) audioManager->PlaySoundManager("enemy_explosion", 0.9f);
+
+                // Restar una vida al jugador
+                game.LoseLife();
+                LOG_INFO(Collision, "Enemy escaped bottom. Player loses a life. Lives left: " << game.GetLives());
+                break;
             }
         }
-        if (bulletConsumed) continue;
     }
+}
 
-    // Colisiones: balas enemigas con jugador y bloques defensivos
-    for (auto& bullet : enemyBullets) {
-        if (!bullet.active) continue;
+void CollisionManager::KillEnemy(EnemyManager& enemies, uint32_t i, Game& game) {
+    EnemyArray& foes = enemies.enemies;
+    const SDL_FRect er = foes.Rect(i);
+    enemies.OnEnemyDied(i);
+    // Si el enemigo era splitter, spawnear dos básicos en posiciones libres cercanas. Se hace ya,
+    // no al final de la fase: los huecos libres son los de este momento (los enemigos que maten
+    // las balas siguientes siguen ocupando el suyo), como en el bucle original. Los hijos se
+    // añaden al final de los arrays, fuera de la rejilla de la detección: no entran en las
+    // colisiones hasta el siguiente paso
+    if (foes.type[i] == EnemyType::Splitter) {
+        const size_t before = foes.Size();
+        SpawnSplitterChildren(foes, i);
+        for (size_t k = before; k < foes.Size(); ++k) enemies.OnEnemySpawned((uint32_t)k);
+    }
 
-        bool bulletHandled = false;
-            // Primero verificar colisión con edificios (skyscrapers)
-            for (auto& block : blocks) {
-                if (!block.alive) continue;
-                if (RectCollision(bullet.rect, block.rect)) {
-                    // Check per-pixel opacity at bullet center so bullets pass through destroyed parts
-                    float cx = bullet.rect.x + bullet.rect.w/2.0f;
-                    float cy = bullet.rect.y + bullet.rect.h/2.0f;
-                    if (block.IsOpaqueAtWorld(cx, cy)) {
-                        int radius = 18; // radio de daño en px (ajustado a 18)
-                        std::cout << "[CollisionManager] Enemy bullet hit skyscraper at " << cx << "," << cy << "\n";
-                        block.TakeBulletHit(cx, cy, radius);
-                        // Force immediate texture update if renderer available so damage is visible this frame
-                        if (renderer) {
-                            block.UpdateTexture(renderer);
-                        }
-                        bullet.active = false;
-                        bulletHandled = true;
-                        particles.CreateExplosion(cx, cy, 8);
-                        break;
-                    } else {
-                        // If the pixel is transparent, the bullet passes through
-                    }
-                }
-            }
-        if (bulletHandled) continue;
+    // Posibilidad de dropear powerup al morir, en la posición del enemigo
+    CollisionEvent drop;
+    drop.kind = CollisionEvent::Kind::Drop;
+    drop.x = er.x + er.w/2;
+    drop.y = er.y + er.h/2;
+    events.push_back(drop);
 
-        // Verificar colisión entre bala enemiga y jugador
-        if (RectCollision(bullet.rect, player.rect)) {
-            // ¡El jugador fue impactado!
+    // Sumar puntos
+    game.AddScore(10);
 
-            // Crear explosión de partículas en la posición del jugador
-            float explosionX = player.rect.x + player.rect.w / 2;
-            float explosionY = player.rect.y + player.rect.h / 2;
-            particles.CreateExplosion(explosionX, explosionY, 8);
+    LOG_INFO(Collision, "¡Enemigo destruido con explosión! +10 puntos");
+}
 
-            // Reproducir sonido de muerte del jugador
-            if (audioManager) {
-                audioManager->PlaySoundManager("player_death", 0.9f);
+void CollisionManager::SpawnSplitterChildren(EnemyArray& foes, uint32_t i) {
+    const SDL_FRect er = foes.Rect(i);
+    // Determinar HP y velocidad para los hijos
+    int childHp = foes.cold[i].maxHealth / 2;
+    if (childHp < 1) childHp = 1;
+    float childSpeed = foes.speed[i] * 1.5f;
+    const int childDamage = foes.cold[i].damage;
+
+    // Intentar colocar a la izquierda y derecha evitando solapamientos
+    float leftX = er.x - er.w - 8.0f;
+    float rightX = er.x + er.w + 8.0f;
+    float childY = er.y;
+
+    // Incluye al hijo izquierdo recién añadido al colocar el derecho
+    auto isFree = [&](float x, float y) {
+        SDL_FRect r = { x, y, er.w, er.h };
+        return FirstOverlap(r, foes.Rects()) == foes.Size();
+    };
+
+    // Ajustar límites de pantalla
+    const float screenW = 800.0f;
+    if (leftX < 0.0f) leftX = 8.0f;
+    if (rightX + er.w > screenW) rightX = screenW - er.w - 8.0f;
+
+    // Crear hijos si hay hueco, si no, buscar pequeñas correcciones
+    if (isFree(leftX, childY)) {
+        foes.Add(leftX, childY, childHp, EnemyColor(255,0,0,255), EnemyType::Basic, childSpeed, childDamage, MovePattern::Straight);
+    } else {
+        // buscar desplazamiento hacia la izquierda
+        for (int off = 16; off <= 160; off += 16) {
+            if (leftX - off >= 0 && isFree(leftX - off, childY)) {
+                foes.Add(leftX - off, childY, childHp, EnemyColor(255,0,0,255), EnemyType::Basic, childSpeed, childDamage, MovePattern::Straight);
+                break;
             }
-
-            bullet.active = false;  // Destruir bala
-
-            // El jugador pierde una vida
-            game.LoseLife();
-
-            std::cout << "¡Jugador impactado! Vidas restantes: " << game.GetLives() << std::endl;
-            continue; // Solo una bala puede impactar por frame
         }
     }
 
-    // Colisiones: enemigos tocando bloques defensivos (destruyen bloque y enemigo)
-    for (auto& enemy : enemies.enemies) {
-        if (!enemy.alive) continue;
-        for (auto& block : blocks) {
-            if (!block.alive) continue;
-            if (RectCollision(enemy.rect, block.rect)) {
-                // enemy collides with skyscraper: compute contact point using intersection center
-                SDL_FRect inter;
-                inter.x = std::max(enemy.rect.x, block.rect.x);
-                inter.y = std::max(enemy.rect.y, block.rect.y);
-                inter.w = std::min(enemy.rect.x + enemy.rect.w, block.rect.x + block.rect.w) - inter.x;
-                inter.h = std::min(enemy.rect.y + enemy.rect.h, block.rect.y + block.rect.h) - inter.y;
-
-                float cx, cy;
-                if (inter.w > 0.0f && inter.h > 0.0f) {
-                    cx = inter.x + inter.w / 2.0f;
-                    cy = inter.y + inter.h / 2.0f;
-                } else {
-                    // fallback to enemy center if intersection degenerate
-                    cx = enemy.rect.x + enemy.rect.w / 2.0f;
-                    cy = enemy.rect.y + enemy.rect.h / 2.0f;
-                }
-
-                int impactRadius = 18; // use same radius as bullet impacts for consistency
-                std::cout << "[CollisionManager] Enemy collided with skyscraper at " << cx << "," << cy << std::endl;
-                block.TakeBulletHit(cx, cy, impactRadius);
-                // Force immediate texture update if renderer available
-                if (renderer) {
-                    block.UpdateTexture(renderer);
-                }
-                // enemy is destroyed on impact
-                enemy.alive = false;
-                particles.CreateExplosion(cx, cy, 10);
-                if (audioManager) audioManager->PlaySoundManager("enemy_explosion", 0.8f);
+    if (isFree(rightX, childY)) {
+        foes.Add(rightX, childY, childHp, EnemyColor(255,0,0,255), EnemyType::Basic, childSpeed, childDamage, MovePattern::Straight);
+    } else {
+        // buscar desplazamiento hacia la derecha
+        for (int off = 16; off <= 160; off += 16) {
+            if (rightX + off + er.w <= screenW && isFree(rightX + off, childY)) {
+                foes.Add(rightX + off, childY, childHp, EnemyColor(255,0,0,255), EnemyType::Basic, childSpeed, childDamage, MovePattern::Straight);
+                break;
             }
         }
     }
+}
 
-    // Detectar colisiones powerups con jugador
-    auto& powerups = game.GetPowerUps();
-    for (auto& pu : powerups) {
-        if (!pu.active) continue;
-        if (RectCollision(pu.rect, player.rect)) {
-            pu.active = false;
-            // Telemetría: powerup recogido (usar API pública)
-            double latency = 0.0;
-            if (pu.spawnAbsTime > 0.0) {
-                double now = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
-                latency = now - pu.spawnAbsTime;
+void CollisionManager::RollDrop(Game& game, float x, float y) {
+    // Posibilidad de dropear powerup al morir (10%) o forzar en modo test
+    // Pero si Game::OnEnemyKilled() ya spawnó un powerup (regla de nivel 1), saltar esta lógica.
+    // Pasar la posición del enemigo para que el powerup forzado aparezca ahí
+    bool spawnedByRule = game.OnEnemyKilled(x, y);
+    if (spawnedByRule) {
+        // Ya se ha generado un powerup por la regla de nivel, no generar más
+        return;
+    }
+    bool forced = game.IsPowerupTestMode();
+    int baseChance = forced ? 100 : 8; // probabilidad base
+    // Darle un pequeño bonus en Nivel 2 (índice 1) para equilibrar drops
+    if (!forced && game.GetCurrentLevel() == 1) baseChance = 12;
+    if (game.GetRng().drops.Range(100) < baseChance) {
+        // Elegir tipo aleatorio de powerup
+        PowerUp::Type chosen = PowerUp::Type::RestoreDefense;
+        if (forced) {
+            // En modo test, ciclar por tipos para poder probarlos todos
+            int idx = game.NextPowerupTestIndex();
+            switch (idx % 6) {
+                case 0: chosen = PowerUp::Type::RestoreDefense; break;
+                case 1: chosen = PowerUp::Type::BulletTime; break;
+                case 2: chosen = PowerUp::Type::ExtraLife; break;
+                case 3: chosen = PowerUp::Type::HomingMissiles; break;
+                case 4: chosen = PowerUp::Type::Shield; break;
+                case 5: chosen = PowerUp::Type::ContinueFire; break;
             }
-            game.RecordPowerupPickup(latency);
-            switch (pu.type) {
-                case PowerUp::Type::RestoreDefense: {
-                    // Restaurar hasta 3 edificios (reconstruir)
-                    int restored = 0;
-                    for (auto& block : blocks) {
-                        if (restored >= 3) break;
-                        // Only restore buildings that still exist (alive == true)
-                        // and have history to roll back.
-                        if (block.alive) {
-                            block.RestoreFromHistory(2, renderer);
-                            if (block.alive) restored++;
-                        }
-                    }
-                    std::cout << "[CollisionManager] PowerUp collected: restored " << restored << " skyscrapers" << std::endl;
-                    break;
-                }
-                case PowerUp::Type::BulletTime: {
-                    // Activar bullet time a través de la API de Game
-                    game.ActivateBulletTime(3.0f);
-                    std::cout << "[CollisionManager] Bullet Time requested for 3s" << std::endl;
-                     break;
-                 }
-                 case PowerUp::Type::ExtraLife: {
-                    game.AddLives(1);
-                    std::cout << "[CollisionManager] Extra life requested" << std::endl;
-                     break;
-                 }
-                     case PowerUp::Type::HomingMissiles: {
-                    game.AddHomingMissiles(3);
-                    std::cout << "[CollisionManager] Homing missiles requested" << std::endl;
-                     break;
-                 }
-                      case PowerUp::Type::ContinueFire: {
-                          // Activar ContinueFire: reducir cadencia por 3s
-                          game.ActivateContinueFire(3.0f);
-                          std::cout << "[CollisionManager] ContinueFire requested (3s)" << std::endl;
-                          break;
-                      }
-                 case PowerUp::Type::Shield: {
-                    game.ActivateShield(3, 2.0f);
-                    std::cout << "[CollisionManager] Shield requested: 3 hits, 2s" << std::endl;
-                     break;
-                 }
-             }
-         }
-     }
+        } else {
+            int r = game.GetRng().drops.Range(6);
+            switch (r) {
+                case 0: chosen = PowerUp::Type::RestoreDefense; break;
+                case 1: chosen = PowerUp::Type::BulletTime; break;
+                case 2: chosen = PowerUp::Type::ExtraLife; break;
+                case 3: chosen = PowerUp::Type::HomingMissiles; break;
+                case 4: chosen = PowerUp::Type::Shield; break;
+                case 5: chosen = PowerUp::Type::ContinueFire; break;
+            }
+        }
 
-    // Detectar enemigos que hayan cruzado la parte inferior de la ventana
-    for (auto& enemy : enemies.enemies) {
-        if (!enemy.alive) continue;
-        const float screenH = 600.0f;
-        if (enemy.rect.y + enemy.rect.h >= screenH) {
-            // El enemigo ha escapado
-            enemy.alive = false; // eliminar enemigo
-
-            // Crear explosión en su posición
-            particles.CreateExplosion(enemy.rect.x + enemy.rect.w/2, enemy.rect.y + enemy.rect.h/2, 12);
-            if (audioManager) audioManager->PlaySoundManager("enemy_explosion", 0.9f);
-
-            // Restar una vida al jugador
-            game.LoseLife();
-            std::cout << "[CollisionManager] Enemy escaped bottom. Player loses a life. Lives left: " << game.GetLives() << std::endl;
+        // Spawn powerup en la posición del enemigo
+        PowerUp pu(x - 9.0f, y, chosen);
+        game.SpawnPowerUp(pu);
+        LOG_INFO(Collision, "PowerUp spawned (" << (int)chosen << ") at " << pu.rect.x << "," << pu.rect.y);
+    }
+}
+
+void CollisionManager::ApplyPickup(PowerUp& pu, std::vector<Skyscraper>& blocks, Game& game, SDL_Renderer* renderer) {
+    pu.active = false;
+    // Telemetría: powerup recogido (usar API pública)
+    double latency = 0.0;
+    if (pu.spawnTime > 0.0) {
+        latency = game.GetSimTime() - pu.spawnTime;
+    }
+    game.RecordPowerupPickup(latency);
+    switch (pu.type) {
+        case PowerUp::Type::RestoreDefense: {
+            // Restaurar hasta 3 edificios (reconstruir)
+            int restored = 0;
+            for (auto& block : blocks) {
+                if (restored >= 3) break;
+                // Only restore buildings that still exist (alive == true)
+                // and have history to roll back.
+                if (block.alive) {
+                    block.RestoreFromHistory(2, renderer);
+                    if (block.alive) restored++;
+                }
+            }
+            LOG_INFO(Collision, "PowerUp collected: restored " << restored << " skyscrapers");
+            break;
+        }
+        case PowerUp::Type::BulletTime: {
+            // Activar bullet time a través de la API de Game
+            game.ActivateBulletTime(3.0f);
+            LOG_INFO(Collision, "Bullet Time requested for 3s");
+            break;
+        }
+        case PowerUp::Type::ExtraLife: {
+            game.AddLives(1);
+            LOG_INFO(Collision, "Extra life requested");
+            break;
+        }
+        case PowerUp::Type::HomingMissiles: {
+            game.AddHomingMissiles(3);
+            LOG_INFO(Collision, "Homing missiles requested");
+            break;
+        }
+        case PowerUp::Type::ContinueFire: {
+            // Activar ContinueFire: reducir cadencia por 3s
+            game.ActivateContinueFire(3.0f);
+            LOG_INFO(Collision, "ContinueFire requested (3s)");
+            break;
+        }
+        case PowerUp::Type::Shield: {
+            game.ActivateShield(3, 2.0f);
+            LOG_INFO(Collision, "Shield requested: 3 hits, 2s");
+            break;
         }
     }
 }
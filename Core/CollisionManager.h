@@ -4,16 +4,74 @@
 #include "Bullet.h"
 #include "ParticleSystem.h"
 #include "AudioManagerMiniaudio.h"
+#include "SpatialGrid.h"
+#include "PowerUp.h"
 #include <vector>
 
 // Forward declaration
 class Game;
 
+// Un contacto detectado o una consecuencia suya. La detección sólo lee el estado y apunta
+// eventos; Resolve los aplica en orden (daño, vidas, puntos, audio, partículas). Un Hit que
+// mata resuelve la muerte en el acto (puntos e hijos de splitter, como el bucle original) y
+// añade su Drop al final del buffer.
+struct CollisionEvent {
+    enum class Kind : uint8_t {
+        Hit,         // bala del jugador -> enemigo (subject = bala, target = enemigo)
+        Drop,        // regla de nivel / tirada de powerup en (x, y)
+        BuildingHit, // bala enemiga -> edificio (subject = bala, target = edificio, impacto en x/y)
+        PlayerHit,   // bala enemiga -> jugador (subject = bala)
+        Ram,         // enemigo contra edificio (subject = enemigo, target = edificio, contacto en x/y)
+        Pickup,      // powerup recogido por el jugador (subject = hueco del pool)
+        Escape       // enemigo por el borde inferior (subject = enemigo)
+    };
+    Kind kind;
+    uint32_t subject = 0;
+    uint32_t target = 0;
+    float x = 0.0f, y = 0.0f;
+};
+
 class CollisionManager {
 public:
     CollisionManager(AudioManagerMiniaudio* audioManager);
-    void CheckCollisions(Player& player, EnemyManager& enemies, std::vector<Bullet>& playerBullets, std::vector<Bullet>& enemyBullets, ParticleSystem& particles, Game& game, SDL_Renderer* renderer = nullptr);
-    
+    // Cada fase detecta (sin tocar nada) y después resuelve sus eventos, en el mismo orden
+    // que antes: balas del jugador, balas enemigas, enemigos contra edificios, powerups y
+    // enemigos escapados. Así cada fase ve lo que resolvieron las anteriores.
+    void CheckCollisions(Player& player, EnemyManager& enemies, BulletArray& playerBullets, BulletArray& enemyBullets, ParticleSystem& particles, Game& game, SDL_Renderer* renderer = nullptr);
+
 private:
+    static constexpr uint32_t kNoTarget = 0xFFFFFFFFu;
+
+    // Detección: sólo lee el estado y añade a out los eventos del tramo [begin, end) (posiciones
+    // de Live() para balas y powerups, índices de enemigo para choques y escapes). Los buffers
+    // de trabajo son del llamador, así que tramos distintos pueden ir en hilos distintos;
+    // concatenar sus out en orden de tramo da los mismos eventos que un solo tramo completo.
+    // DetectPlayerBullets necesita enemyGrid construida antes.
+    void DetectPlayerBullets(const EnemyArray& foes, const BulletArray& playerBullets, size_t begin, size_t end, std::vector<uint32_t>& scratch, std::vector<CollisionEvent>& out) const;
+    void DetectEnemyBullets(const std::vector<Skyscraper>& blocks, const Player& player, const BulletArray& enemyBullets, size_t begin, size_t end, std::vector<CollisionEvent>& out) const;
+    void DetectRams(const EnemyArray& foes, const std::vector<Skyscraper>& blocks, size_t begin, size_t end, std::vector<uint64_t>& masks, std::vector<CollisionEvent>& out) const;
+    void DetectPickups(const Player& player, const PowerUpPool& powerups, size_t begin, size_t end, std::vector<CollisionEvent>& out) const;
+    void DetectEscapes(const EnemyArray& foes, size_t begin, size_t end, std::vector<CollisionEvent>& out) const;
+
+    // Primer enemigo vivo con índice >= from que toca r (kNoTarget si ninguno)
+    uint32_t FirstEnemyContact(const EnemyArray& foes, const SDL_FRect& r, uint32_t from, std::vector<uint32_t>& scratch) const;
+    // Primer contacto de una bala enemiga: edificio opaco en su centro o, si no, el jugador
+    static bool EnemyBulletContact(const std::vector<Skyscraper>& blocks, const Player& player, const BulletArray& enemyBullets, uint32_t b, CollisionEvent& out);
+
+    void Resolve(Player& player, EnemyManager& enemies, BulletArray& playerBullets, BulletArray& enemyBullets, ParticleSystem& particles, Game& game, SDL_Renderer* renderer);
+    // Muerte por bala: hijos de splitter ya (ocupan huecos según lo muerto hasta este Hit) y Drop al final
+    void KillEnemy(EnemyManager& enemies, uint32_t i, Game& game);
+    void SpawnSplitterChildren(EnemyArray& foes, uint32_t i);
+    void RollDrop(Game& game, float x, float y);
+    void ApplyPickup(PowerUp& pu, std::vector<Skyscraper>& blocks, Game& game, SDL_Renderer* renderer);
+
     AudioManagerMiniaudio* audioManager;
+    // Fase ancha balas del jugador -> enemigos (se rehace en cada CheckCollisions)
+    SpatialGrid enemyGrid;
+    // Buffers de trabajo de la detección en este hilo: candidatos de la rejilla y máscaras
+    // edificio x enemigos de DetectRams
+    std::vector<uint32_t> candidates;
+    std::vector<uint64_t> ramMasks;
+    // Buffer de eventos de la fase en curso (se reutiliza: sin reservas en régimen estable)
+    std::vector<CollisionEvent> events;
 };
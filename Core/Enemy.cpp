@@ -1,141 +1,197 @@
 #include "Enemy.h"
 #include <cmath>
-#include <cstdlib>
+#include <cstring>
 
+size_t EnemyArray::Add(float x_, float y_, int hp, EnemyColor color_, EnemyType type_, float speed_, int damage_, MovePattern pattern_) {
+    x.push_back(x_);
+    y.push_back(y_);
+    w.push_back(40.0f);
+    h.push_back(20.0f);
+    prevX.push_back(x_);
+    prevY.push_back(y_);
+    alive.push_back(1);
+    health.push_back(hp);
+    speed.push_back(speed_);
+    patternTimer.push_back(0.0f);
+    type.push_back(type_);
+    pattern.push_back(pattern_);
+    EnemyCold c;
+    c.maxHealth = hp;
+    c.damage = damage_;
+    c.color = color_;
+    cold.push_back(c);
+    return x.size() - 1;
+}
 
+void EnemyArray::Clear() {
+    x.clear(); y.clear(); w.clear(); h.clear();
+    prevX.clear(); prevY.clear();
+    alive.clear(); health.clear();
+    speed.clear(); patternTimer.clear();
+    type.clear(); pattern.clear();
+    cold.clear();
+}
 
-Enemy::Enemy(float x, float y, int hp, EnemyColor color_, EnemyType type_, float speed_, int damage_, MovePattern pattern_)
-    : health(hp), maxHealth(hp), damage(damage_), speed(speed_), color(color_), type(type_), pattern(pattern_)
-{
-    rect = { x, y, 40, 20 };
-    isSplitter = (type == EnemyType::Splitter);
-    isBoss = (type == EnemyType::Boss);
-    isSniper = (type == EnemyType::Sniper);
+void EnemyArray::Reserve(size_t n) {
+    x.reserve(n); y.reserve(n); w.reserve(n); h.reserve(n);
+    prevX.reserve(n); prevY.reserve(n);
+    alive.reserve(n); health.reserve(n);
+    speed.reserve(n); patternTimer.reserve(n);
+    type.reserve(n); pattern.reserve(n);
+    cold.reserve(n);
 }
 
-void Enemy::Update(float dt) {
-    if (!alive) return;
-    patternTimer += dt;
+int EnemyArray::AliveCount() const {
+    int n = 0;
+    for (uint8_t a : alive) n += a;
+    return n;
+}
 
+void EnemyArray::SavePrevRects() {
+    if (x.empty()) return;
+    std::memcpy(prevX.data(), x.data(), x.size() * sizeof(float));
+    std::memcpy(prevY.data(), y.data(), y.size() * sizeof(float));
+}
+
+void EnemyArray::TakeDamage(size_t i, int amount) {
+    if (!alive[i]) return;
+    health[i] -= amount;
+    if (health[i] <= 0) {
+        alive[i] = 0;
+        // Aquí se puede manejar lógica especial: splitter, boss, etc.
+    }
+}
+
+void EnemyArray::UpdateBossDecision(size_t i, float dt, Rng& rng) {
+    if (!alive[i] || type[i] != EnemyType::Boss) return;
     // Logic shared for bosses: decisión periódica
-    if (isBoss) {
-        decisionTimer += dt;
-        if (decisionTimer >= decisionInterval) {
-            decisionTimer = 0.0f;
-            int r = rand() % 100;
-            // 65% maneuver
-            if (r < 65) {
-                bossAction = BossAction::Maneuver;
-                actionDuration = 1.0f + (rand() % 200) / 100.0f; // 1.0 - 3.0s aprox
-                actionTimer = actionDuration;
-            }
-            // 20% teleport
-            else if (r < 85) {
-                // Planificar teleport a posición aleatoria horizontal manteniendo y
-                const float screenW = 800.0f;
-                float margin = 20.0f;
-                float maxX = screenW - rect.w - margin;
-                float newX = margin + (rand() / (float)RAND_MAX) * (maxX - margin);
-                // No mover aún; guardar solicitud de teleport para que EnemyManager verifique huecos libres
-                pendingTeleportX = newX;
-                wantsTeleport = true;
-                bossAction = BossAction::None;
-            }
-            // 10% triple shot
-            else if (r < 95) {
-                bossAction = BossAction::TripleShot;
-                actionTimer = 0.5f; // ventana corta para que EnemyManager dispare
-            }
-            // restante 5% nada
+    EnemyCold& c = cold[i];
+    c.decisionTimer += dt;
+    if (c.decisionTimer >= c.decisionInterval) {
+        c.decisionTimer = 0.0f;
+        int r = rng.Range(100);
+        // 65% maneuver
+        if (r < 65) {
+            c.bossAction = BossAction::Maneuver;
+            c.actionDuration = 1.0f + rng.Range(200) / 100.0f; // 1.0 - 3.0s aprox
+            c.actionTimer = c.actionDuration;
+        }
+        // 20% teleport
+        else if (r < 85) {
+            // Planificar teleport a posición aleatoria horizontal manteniendo y
+            const float screenW = 800.0f;
+            float margin = 20.0f;
+            float maxX = screenW - w[i] - margin;
+            float newX = margin + rng.Float01() * (maxX - margin);
+            // No mover aún; guardar solicitud de teleport para que EnemyManager verifique huecos libres
+            c.pendingTeleportX = newX;
+            c.wantsTeleport = true;
+            c.bossAction = BossAction::None;
         }
+        // 10% triple shot
+        else if (r < 95) {
+            c.bossAction = BossAction::TripleShot;
+            c.actionTimer = 0.5f; // ventana corta para que EnemyManager dispare
+        }
+        // restante 5% nada
     }
+}
+
+void EnemyArray::Move(size_t i, float dt) {
+    if (!alive[i]) return;
+    float t = (patternTimer[i] += dt);
+    float& px = x[i];
+    float& py = y[i];
+    const float s = speed[i];
 
-    switch (type) {
+    switch (type[i]) {
         case EnemyType::Basic:
             // Movimiento según patrón
-            switch (pattern) {
+            switch (pattern[i]) {
                 case MovePattern::Straight:
-                    rect.y += speed * 30 * dt;
+                    py += s * 30 * dt;
                     break;
                 case MovePattern::ZigZag:
-                    rect.x += std::sin(patternTimer * 2.5f) * 60 * dt;
-                    rect.y += speed * 20 * dt;
+                    px += std::sin(t * 2.5f) * 60 * dt;
+                    py += s * 20 * dt;
                     break;
                 case MovePattern::Diagonal:
-                    rect.x += speed * 20 * dt;
-                    rect.y += speed * 20 * dt;
+                    px += s * 20 * dt;
+                    py += s * 20 * dt;
                     break;
                 default: break;
             }
             break;
         case EnemyType::Fast:
-            switch (pattern) {
+            switch (pattern[i]) {
                 case MovePattern::ZigZag:
-                    rect.x += std::sin(patternTimer * 5.0f) * 120 * dt;
-                    rect.y += speed * 60 * dt;
+                    px += std::sin(t * 5.0f) * 120 * dt;
+                    py += s * 60 * dt;
                     break;
                 case MovePattern::Dive:
-                    rect.y += speed * 120 * dt;
+                    py += s * 120 * dt;
                     break;
                 default: break;
             }
             break;
         case EnemyType::Tank:
-            switch (pattern) {
+            switch (pattern[i]) {
                 case MovePattern::Straight:
-                    rect.y += speed * 10 * dt;
+                    py += s * 10 * dt;
                     break;
                 case MovePattern::DescendStopShoot:
-                    if (rect.y < 200) rect.y += speed * 20 * dt;
+                    if (py < 200) py += s * 20 * dt;
                     // luego se queda quieto y dispara
                     break;
                 default: break;
             }
             break;
-        case EnemyType::Boss:
+        case EnemyType::Boss: {
+            EnemyCold& c = cold[i];
             // Ejecutar acción si hay alguna
-            if (bossAction == BossAction::Maneuver && actionTimer > 0.0f) {
+            if (c.bossAction == BossAction::Maneuver && c.actionTimer > 0.0f) {
                 // Zigzag evasivo: usar sin para moverse horizontalmente rápido
-                rect.x += std::sin(patternTimer * 6.0f) * 160 * dt;
+                px += std::sin(t * 6.0f) * 160 * dt;
                 // pequeño desplazamiento vertical para simular maniobra
-                rect.y += std::sin(patternTimer * 3.0f) * 8.0f * dt;
-                actionTimer -= dt;
-                if (actionTimer <= 0.0f) bossAction = BossAction::None;
+                py += std::sin(t * 3.0f) * 8.0f * dt;
+                c.actionTimer -= dt;
+                if (c.actionTimer <= 0.0f) c.bossAction = BossAction::None;
             } else {
                 // Comportamiento por patrón cuando no está maniobrando
-                switch (pattern) {
+                switch (pattern[i]) {
                     case MovePattern::Circle:
-                        rect.x += std::cos(patternTimer) * 80 * dt;
-                        rect.y += std::sin(patternTimer) * 40 * dt;
+                        px += std::cos(t) * 80 * dt;
+                        py += std::sin(t) * 40 * dt;
                         break;
                     case MovePattern::ZigZag:
-                        rect.x += std::sin(patternTimer * 2.0f) * 100 * dt;
+                        px += std::sin(t * 2.0f) * 100 * dt;
                         break;
                     default: break;
                 }
             }
             // actionTimer para triple shot se deja para que EnemyManager lo detecte
             break;
+        }
         case EnemyType::Sniper:
-            switch (pattern) {
+            switch (pattern[i]) {
                 case MovePattern::Stationary:
                     // Quieto
                     break;
                 case MovePattern::ZigZag:
-                    rect.x += std::sin(patternTimer * 1.5f) * 40 * dt;
+                    px += std::sin(t * 1.5f) * 40 * dt;
                     break;
                 default: break;
             }
             break;
         case EnemyType::Splitter:
-            switch (pattern) {
+            switch (pattern[i]) {
                 case MovePattern::ZigZag:
-                    rect.x += std::sin(patternTimer * 2.0f) * 60 * dt;
-                    rect.y += speed * 30 * dt;
+                    px += std::sin(t * 2.0f) * 60 * dt;
+                    py += s * 30 * dt;
                     break;
                 case MovePattern::Scatter:
-                    rect.x += (phase == 0 ? -1 : 1) * speed * 40 * dt;
-                    rect.y += speed * 30 * dt;
+                    px += (cold[i].phase == 0 ? -1 : 1) * s * 40 * dt;
+                    py += s * 30 * dt;
                     break;
                 default: break;
             }
@@ -144,43 +200,37 @@ void Enemy::Update(float dt) {
     }
 }
 
-void Enemy::Render(SDL_Renderer* renderer) {
-    if (!alive) return;
-
-    // Try to draw a sprite if the Renderer provided one via renderer's user data.
-    // The project has a Renderer class that stores the texture; as a lightweight approach
-    // we attempt to query a texture by getting the SDL_Renderer associated texture through
-    // a custom function. Since this file doesn't have direct access to Renderer instance,
-    // we'll attempt to find a texture named "enemy" stored in the renderer's userdata pointer
-    // (set elsewhere). If not found, fallback to rect rendering.
-
-    // The project's Renderer class exposes GetEnemyTexture() and the Game code uses a single
-    // global Renderer; to keep changes minimal, we'll check for an attached texture via
-    // SDL_GetRendererInfo userdata is not reliable, so instead we accept a convention: the
-    // Renderer sets the SDL_Renderer user data to an SDL_Texture* for enemy under key "ENEMY_TEX"
-    // If that is not the case, fallback.
-
-    // Fallback: simple filled rect
-    SDL_Texture* tex = nullptr;
-    // try to retrieve a pointer stored as renderer's draw color userdata (non-standard),
-    // but since we can't guarantee, we'll simply attempt to render the rect if no texture is set.
-
-    // NOTE: Downstream we will update Game to pass the Renderer instance or expose texture.
-    // For now: normal filled rect (maintain prior behavior).
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-    SDL_RenderFillRect(renderer, &rect);
-    if (isBoss) {
-        SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
-        SDL_FRect outline = { rect.x - 2.0f, rect.y - 2.0f, rect.w + 4.0f, rect.h + 4.0f };
-        SDL_RenderRect(renderer, &outline);
+void EnemyArray::RenderFallback(SpriteBatch& batch, size_t i, float alpha) const {
+    if (!alive[i]) return;
+    const EnemyColor& color = cold[i].color;
+    SDL_FRect r = RenderRect(i, alpha);
+    batch.FillRect(r, SDL_Color{ color.r, color.g, color.b, color.a });
+    if (IsBoss(i)) {
+        SDL_FRect outline = { r.x - 2.0f, r.y - 2.0f, r.w + 4.0f, r.h + 4.0f };
+        batch.OutlineRect(outline, SDL_Color{ 255, 255, 0, 255 });
     }
 }
 
-void Enemy::TakeDamage(int amount) {
-    if (!alive) return;
-    health -= amount;
-    if (health <= 0) {
-        alive = false;
-        // Aquí se puede manejar lógica especial: splitter, boss, etc.
-    }
+void EnemyArray::SaveState(StateWriter& wr) const {
+    wr.PutVector(x); wr.PutVector(y); wr.PutVector(w); wr.PutVector(h);
+    wr.PutVector(prevX); wr.PutVector(prevY);
+    wr.PutVector(alive); wr.PutVector(health);
+    wr.PutVector(speed); wr.PutVector(patternTimer);
+    wr.PutVector(type); wr.PutVector(pattern);
+    wr.PutVector(cold);
+}
+
+bool EnemyArray::RestoreState(StateReader& r) {
+    r.GetVector(x); r.GetVector(y); r.GetVector(w); r.GetVector(h);
+    r.GetVector(prevX); r.GetVector(prevY);
+    r.GetVector(alive); r.GetVector(health);
+    r.GetVector(speed); r.GetVector(patternTimer);
+    r.GetVector(type); r.GetVector(pattern);
+    r.GetVector(cold);
+    if (!r.Ok()) return false;
+    // Todos los arrays deben tener la misma longitud
+    const size_t n = x.size();
+    return y.size() == n && w.size() == n && h.size() == n && prevX.size() == n && prevY.size() == n &&
+           alive.size() == n && health.size() == n && speed.size() == n && patternTimer.size() == n &&
+           type.size() == n && pattern.size() == n && cold.size() == n;
 }
@@ -1,14 +1,20 @@
 #pragma once
-#include "Entity.h"
-#include "IEnemy.h" 
+#include <SDL3/SDL.h>
+#include <cstdint>
+#include <vector>
+#include "Rng.h"
+#include "GameState.h"
+#include "AabbBatch.h"
+#include "SpriteBatch.h"
 
 struct EnemyColor {
     Uint8 r, g, b, a;
+    EnemyColor() : r(255), g(0), b(0), a(255) {}
     EnemyColor(Uint8 r_, Uint8 g_, Uint8 b_, Uint8 a_ = 255) : r(r_), g(g_), b(b_), a(a_) {}
 };
 
 
-enum class EnemyType {
+enum class EnemyType : uint8_t {
     Basic,
     Fast,
     Tank,
@@ -17,7 +23,7 @@ enum class EnemyType {
     Splitter
 };
 
-enum class MovePattern {
+enum class MovePattern : uint8_t {
     Straight,
     ZigZag,
     Diagonal,
@@ -29,31 +35,17 @@ enum class MovePattern {
     None
 };
 
-class Enemy : public Entity, public IEnemy {
-public:
-    Enemy(float x, float y, int hp = 1, EnemyColor color = EnemyColor(255,0,0,255),
-          EnemyType type = EnemyType::Basic, float speed = 1.0f, int damage = 1, MovePattern pattern = MovePattern::Straight);
-    void Update(float dt) override;
-    void Render(SDL_Renderer* renderer) override;
-        void TakeDamage(int amount) override; // Declaration only, implementation in Enemy.cpp
-    bool IsAlive() const override { return alive; }
+// Comportamiento especial para bosses
+enum class BossAction : uint8_t { None, Maneuver, Teleport, TripleShot };
 
-    bool alive = true;
-    int health = 1;
+// Datos fríos de un enemigo: sólo se leen al morir, al dibujar o en la lógica de bosses,
+// así que no comparten línea de caché con las posiciones que recorren movimiento y colisiones
+struct EnemyCold {
     int maxHealth = 1;
     int damage = 1;
-    float speed = 1.0f;
     EnemyColor color;
-    EnemyType type = EnemyType::Basic;
-    MovePattern pattern = MovePattern::Straight;
-    bool isSplitter = false;
-    bool isBoss = false;
-    bool isSniper = false;
-    float patternTimer = 0.0f;
-    int phase = 0; // Para bosses
+    int phase = 0; // Para bosses / scatter
 
-    // Comportamiento especial para bosses
-    enum class BossAction { None, Maneuver, Teleport, TripleShot };
     BossAction bossAction = BossAction::None;
     float actionTimer = 0.0f;      // tiempo restante de la acción
     float actionDuration = 0.0f;   // duración planificada
@@ -64,3 +56,57 @@ public:
     float pendingTeleportX = -1.0f;
     bool wantsTeleport = false;
 };
+
+// Enemigos de la partida en formato SoA (un array por campo, indexados por enemigo).
+// Los bucles de movimiento y colisión recorren x/y/w/h/alive de forma contigua sin pasar
+// por vtables ni por los campos de boss. Los enemigos muertos se quedan en su hueco
+// (alive = 0) hasta el siguiente LoadLevel, igual que antes con std::vector<Enemy>.
+class EnemyArray {
+public:
+    size_t Add(float x, float y, int hp = 1, EnemyColor color = EnemyColor(255,0,0,255),
+               EnemyType type = EnemyType::Basic, float speed = 1.0f, int damage = 1, MovePattern pattern = MovePattern::Straight);
+    void Clear();
+    void Reserve(size_t n);
+    size_t Size() const { return x.size(); }
+    bool Empty() const { return x.empty(); }
+    int AliveCount() const;
+
+    SDL_FRect Rect(size_t i) const { return { x[i], y[i], w[i], h[i] }; }
+    // Vista SoA para los solapes en lote (los muertos no cuentan). Add invalida los punteros
+    RectSoA Rects() const { return { x.data(), y.data(), w.data(), h.data(), alive.data(), x.size() }; }
+    // Posición interpolada entre el paso anterior y el actual para dibujar
+    SDL_FRect RenderRect(size_t i, float alpha) const {
+        return { prevX[i] + (x[i] - prevX[i]) * alpha, prevY[i] + (y[i] - prevY[i]) * alpha, w[i], h[i] };
+    }
+    float CenterX(size_t i) const { return x[i] + w[i] / 2; }
+    float CenterY(size_t i) const { return y[i] + h[i] / 2; }
+    bool IsBoss(size_t i) const { return type[i] == EnemyType::Boss; }
+
+    // Game::Step lo llama antes de mover (base de la interpolación)
+    void SavePrevRects();
+    void TakeDamage(size_t i, int amount);
+    // Movimiento según tipo/patrón de un enemigo vivo
+    void Move(size_t i, float dt);
+    // Decisión periódica de los bosses (maniobra/teleport/triple disparo) con el stream de
+    // RNG de enemigos de la partida. EnemyManager la llama antes de Move.
+    void UpdateBossDecision(size_t i, float dt, Rng& rng);
+    // Dibujo sin textura: rectángulo del color del enemigo (+ marco si es boss)
+    void RenderFallback(SpriteBatch& batch, size_t i, float alpha) const;
+
+    // Snapshot (Game::SaveState): todos los arrays
+    void SaveState(StateWriter& w) const;
+    bool RestoreState(StateReader& r);
+
+    // Caliente: posición, tamaño, vida
+    std::vector<float> x, y, w, h;
+    std::vector<float> prevX, prevY;
+    std::vector<uint8_t> alive;
+    std::vector<int> health;
+    // Movimiento
+    std::vector<float> speed;
+    std::vector<float> patternTimer;
+    std::vector<EnemyType> type;
+    std::vector<MovePattern> pattern;
+    // Frío
+    std::vector<EnemyCold> cold;
+};
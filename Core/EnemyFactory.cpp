@@ -1,34 +1,46 @@
 #include "EnemyFactory.h"
 #include "Enemy.h"
-#include <iostream>
+#include "Log.h"
+#include "AssetPack.h"
 #include <fstream>
 #include "../libs/nlohmann/json.hpp"
 
 using json = nlohmann::json;
 
-std::vector<Enemy> EnemyFactory::CreateEnemiesFromLevels(const std::string& jsonFilePath, int levelIndex) {
-    std::vector<Enemy> enemies;
-    std::ifstream file(jsonFilePath);
-    if (!file.is_open()) {
-        std::cout << "[EnemyFactory] No se pudo abrir el archivo: " << jsonFilePath << std::endl;
-        return enemies;
-    }
+EnemyArray EnemyFactory::CreateEnemiesFromLevels(const std::string& jsonFilePath, int levelIndex) {
+    EnemyArray enemies;
     json data;
-    file >> data;
+    AssetPack::Item item;
+    if (AssetPack::Get().Find(jsonFilePath, item) && item.kind == AssetPack::Kind::Levels) {
+        // Compilado a MessagePack por el packer: sin abrir fichero ni parsear texto
+        const uint8_t* bytes = (const uint8_t*)item.data;
+        data = json::from_msgpack(bytes, bytes + item.size, true, false);
+        if (!data.is_discarded()) LOG_DEBUG(Assets, jsonFilePath << " desde el paquete");
+    }
+    if (data.is_discarded() || data.is_null()) {
+        std::ifstream file(jsonFilePath);
+        if (!file.is_open()) {
+            LOG_WARN(Assets, "No se pudo abrir el archivo: " << jsonFilePath);
+            return enemies;
+        }
+        file >> data;
+        LOG_DEBUG(Assets, jsonFilePath << " desde fichero suelto");
+    }
     if (!data.contains("levels")) {
-        std::cout << "[EnemyFactory] El archivo no contiene 'levels'." << std::endl;
+        LOG_WARN(Assets, "El archivo no contiene 'levels'.");
         return enemies;
     }
     if (levelIndex < 0 || levelIndex >= data["levels"].size()) {
-        std::cout << "[EnemyFactory] Índice de nivel fuera de rango: " << levelIndex << std::endl;
+        LOG_WARN(Assets, "Índice de nivel fuera de rango: " << levelIndex);
         return enemies;
     }
     const auto& level = data["levels"][levelIndex];
     if (!level.contains("enemies")) {
-        std::cout << "[EnemyFactory] El nivel no contiene 'enemies'." << std::endl;
+        LOG_WARN(Assets, "El nivel no contiene 'enemies'.");
         return enemies;
     }
     int count = 0;
+    enemies.Reserve(level["enemies"].size());
     for (const auto& enemyData : level["enemies"]) {
         std::string typeStr = enemyData.value("type", "basic");
         float x = enemyData.value("x", 0.0f);
@@ -58,10 +70,9 @@ std::vector<Enemy> EnemyFactory::CreateEnemiesFromLevels(const std::string& json
         else if (patternStr == "stationary") pattern = MovePattern::Stationary;
         else if (patternStr == "scatter") pattern = MovePattern::Scatter;
 
-        Enemy enemy(x, y, hp, color, type, speed, damage, pattern);
-        enemies.push_back(enemy);
+        enemies.Add(x, y, hp, color, type, speed, damage, pattern);
         count++;
     }
-    std::cout << "[EnemyFactory] Enemigos cargados para el nivel " << levelIndex << ": " << count << std::endl;
+    LOG_INFO(Assets, "Enemigos cargados para el nivel " << levelIndex << ": " << count);
     return enemies;
 }
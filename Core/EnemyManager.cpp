@@ -1,23 +1,22 @@
 #include "EnemyManager.h"
 #include "EnemyFactory.h"
 #include <cstdlib>
-#include <ctime>
-#include <iostream>
+#include <cstdio>
+#include "Log.h"
 #include <cmath>
+#include <algorithm>
 
-EnemyManager::EnemyManager() {
+EnemyManager::EnemyManager(GameRng& rng_) : rng(rng_) {
     LoadLevel(0); // Cargar nivel 1 por defecto
-    std::cout << "[EnemyManager] Enemigos tras LoadLevel: " << enemies.size() << std::endl;
-    if (!enemies.empty()) {
-        int vivos = 0;
-        for (const auto& e : enemies) if (e.alive) vivos++;
-        std::cout << "[EnemyManager] Enemigos vivos al inicio: " << vivos << std::endl;
+    LOG_INFO(Enemies, "Enemigos tras LoadLevel: " << enemies.Size());
+    if (!enemies.Empty()) {
+        LOG_INFO(Enemies, "Enemigos vivos al inicio: " << enemies.AliveCount());
     }
-    srand((unsigned)time(nullptr));
 }
 
 void EnemyManager::LoadLevel(int levelIndex) {
     enemies = EnemyFactory::CreateEnemiesFromLevels("Data/levels.json", levelIndex);
+    shooterIndex.Rebuild(enemies);
     // Crear defensas estándar: dos líneas de bloques solo si no existen (persisten entre niveles)
     // defenseBlocks.clear();
 
@@ -27,7 +26,7 @@ void EnemyManager::LoadLevel(int levelIndex) {
         const float margin = 40.0f; // margen lateral
     const float blockW = 80.0f;
     const float blockH = 140.0f; // skyscraper height
-    const int columns = 6; // aumentar columnas para cubrir laterales
+    const int columns = kBuildingColumns; // aumentar columnas para cubrir laterales
 
         float gap = 10.0f;
         if (columns > 1) {
@@ -39,22 +38,27 @@ void EnemyManager::LoadLevel(int levelIndex) {
         for (int i = 0; i < columns; ++i) {
             float x = margin + i * (blockW + gap);
             float y = 400.0f; // base y
-            // Attempt to use asset path names build_01..build_06.png (relative)
-            char buf[128];
-            sprintf(buf, "assets/sprites/build_%02d.png", (i+1));
-            defenseBlocks.emplace_back(x, y, blockW, blockH, std::string(buf));
+            defenseBlocks.emplace_back(x, y, blockW, blockH, BuildingImagePath(i));
             // Ensure the mutable surface exists immediately (texture created later when renderer is available)
             defenseBlocks.back().Initialize(nullptr);
         }
-        std::cout << "[EnemyManager] Defense blocks created: " << defenseBlocks.size() << std::endl;
+        LOG_INFO(Enemies, "Defense blocks created: " << defenseBlocks.size());
     } else {
-        std::cout << "[EnemyManager] Defense blocks preserved across levels: " << defenseBlocks.size() << std::endl;
+        LOG_INFO(Enemies, "Defense blocks preserved across levels: " << defenseBlocks.size());
     }
 }
 
+std::string EnemyManager::BuildingImagePath(int column) {
+    // Attempt to use asset path names build_01..build_06.png (relative)
+    char buf[128];
+    snprintf(buf, sizeof(buf), "assets/sprites/build_%02d.png", column + 1);
+    return buf;
+}
+
 void EnemyManager::Update(float dt) {
     moveTimer += dt;
     shootTimer += dt;
+    const size_t n = enemies.Size();
     
     // Movimiento más rápido - cada 0.3 segundos en lugar de 1 segundo
     if (moveTimer >= 0.3f) {
@@ -62,9 +66,10 @@ void EnemyManager::Update(float dt) {
         
         // Verificar si algún enemigo toca los bordes
         bool hitEdge = false;
-        for (auto& e : enemies) {
-            if (e.alive) {
-                if ((direction > 0 && e.rect.x >= 750) || (direction < 0 && e.rect.x <= 10)) {
+        for (size_t i = 0; i < n; ++i) {
+            if (enemies.alive[i]) {
+                float ex = enemies.x[i];
+                if ((direction > 0 && ex >= 750) || (direction < 0 && ex <= 10)) {
                     hitEdge = true;
                     break;
                 }
@@ -74,198 +79,242 @@ void EnemyManager::Update(float dt) {
         // Si toca el borde, cambiar dirección y bajar
         if (hitEdge) {
             direction *= -1;
-            for (auto& e : enemies) {
-                if (e.alive) {
-                    e.rect.y += 25; // Bajar más rápido
+            for (size_t i = 0; i < n; ++i) {
+                if (enemies.alive[i]) {
+                    enemies.y[i] += 25; // Bajar más rápido
                 }
             }
         } else {
             // Intentar mover cada enemigo horizontalmente, evitando solapamientos
-            // Ahora usamos la velocidad por-enemigo (e.speed) como multiplicador para el desplazamiento
-            const float baseDelta = 35.0f; // desplazamiento base por tick
-            auto wouldOverlap = [&](const SDL_FRect& a, const SDL_FRect& b) {
-                return (a.x < b.x + b.w && a.x + a.w > b.x && a.y < b.y + b.h && a.y + a.h > b.y);
-            };
-
-            // Para mantener la formación, evaluamos cada enemigo individualmente
-            for (size_t i = 0; i < enemies.size(); ++i) {
-                auto& e = enemies[i];
-                if (!e.alive) continue;
-                float delta = baseDelta * direction * e.speed; // usa speed del enemigo
-                SDL_FRect pred = e.rect;
-                pred.x += delta;
-
-                bool collision = false;
-                // Comprobar colisión con otros enemigos vivos
-                for (size_t j = 0; j < enemies.size(); ++j) {
-                    if (i == j) continue;
-                    auto& other = enemies[j];
-                    if (!other.alive) continue;
-                    if (wouldOverlap(pred, other.rect)) { collision = true; break; }
-                }
-
-                // Si no colisiona con otro enemigo, aplicar movimiento
-                if (!collision) {
-                    e.rect.x = pred.x;
-                }
-                // Si collision=true, dejamos al enemigo en su lugar (evita solapamiento)
-            }
+            MoveFormationStep();
         }
     }
     
-    for (auto& e : enemies) {
-        e.Update(dt);
+    shooterIndex.BeginBosses();
+    for (size_t i = 0; i < n; ++i) {
+        if (enemies.IsBoss(i)) enemies.UpdateBossDecision(i, dt, rng.enemies);
+        enemies.Move(i, dt);
 
         // Si el boss solicitó teletransportarse, verificar hueco libre y aplicar
-        if (e.alive && e.wantsTeleport) {
-            auto rectWouldOverlap = [&](const SDL_FRect& a, const SDL_FRect& b) {
-                return (a.x < b.x + b.w && a.x + a.w > b.x && a.y < b.y + b.h && a.y + a.h > b.y);
-            };
+        if (enemies.alive[i] && enemies.cold[i].wantsTeleport) ResolveTeleport(i);
+        // Posición final del paso: recolocar en el índice de tiradores si se ha movido
+        shooterIndex.OnMove(enemies, (uint32_t)i);
+        shooterIndex.NoteBoss(enemies, (uint32_t)i);
 
-            const float screenW = 800.0f;
-            float targetX = e.pendingTeleportX;
-            if (targetX < 0.0f) targetX = e.rect.x;
-            SDL_FRect cand = { targetX, e.rect.y, e.rect.w, e.rect.h };
+        // Si el enemigo cruza la parte inferior de la ventana, avisar para que CollisionManager gestione la pérdida de vida
+        const float screenH = 600.0f; // altura de ventana
+        if (enemies.alive[i] && (enemies.y[i] + enemies.h[i] >= screenH)) {
+            // No marcamos alive = 0 aquí para que CollisionManager pueda detectarlo y restar la vida
+            LOG_DEBUG(Enemies, "Enemy reached bottom at x=" << enemies.x[i] << " y=" << enemies.y[i] << ". CollisionManager will handle life loss.");
+        }
+    }
+}
 
-            auto overlapsAny = [&](const SDL_FRect& r) {
-                // comprobar con otros enemigos
-                for (auto& other : enemies) {
-                    if (&other == &e) continue;
-                    if (!other.alive) continue;
-                    if (rectWouldOverlap(r, other.rect)) return true;
-                }
-                // comprobar con bloques defensivos
-                for (auto& b : defenseBlocks) {
-                    if (!b.alive) continue;
-                    if (rectWouldOverlap(r, b.rect)) return true;
-                }
-                return false;
-            };
+void EnemyManager::MoveFormationStep() {
+    // Cada enemigo (en orden de índice) avanza baseDelta * speed si su rect desplazado no
+    // solapa a ningún otro enemigo vivo en su posición actual (los anteriores ya movidos).
+    // En lugar de probar contra todos (O(N²)), se ordenan los vivos por (fila, x) una vez y
+    // cada enemigo sólo mira las filas que puede tocar y, dentro de ellas, la ventana de x
+    // alcanzable: los vecinos se han movido como mucho maxDelta desde la x ordenada, así que
+    // la ventana amplía el rango en esa cantidad y el resultado es el mismo que el bucle doble.
+    const float baseDelta = 35.0f; // desplazamiento base por tick
+    const size_t n = enemies.Size();
+    float* ex = enemies.x.data();
+    const float* ey = enemies.y.data();
+    const float* ew = enemies.w.data();
+    const float* eh = enemies.h.data();
+    const uint8_t* alive = enemies.alive.data();
 
-            bool placed = false;
-            if (!overlapsAny(cand)) {
-                e.rect.x = cand.x;
-                placed = true;
-            } else {
-                // buscar huecos a izquierda/derecha
-                for (int off = 16; off <= 240 && !placed; off += 16) {
-                    float lx = targetX - off;
-                    float rx = targetX + off;
-                    if (lx >= 0.0f) {
-                        SDL_FRect r2 = { lx, e.rect.y, e.rect.w, e.rect.h };
-                        if (!overlapsAny(r2)) { e.rect.x = lx; placed = true; break; }
-                    }
-                    if (rx + e.rect.w <= screenW) {
-                        SDL_FRect r3 = { rx, e.rect.y, e.rect.w, e.rect.h };
-                        if (!overlapsAny(r3)) { e.rect.x = rx; placed = true; break; }
-                    }
-                }
-            }
+    float maxW = 0.0f, maxH = 0.0f, maxDelta = 0.0f;
+    for (size_t i = 0; i < n; ++i) {
+        if (!alive[i]) continue;
+        maxW = std::max(maxW, ew[i]);
+        maxH = std::max(maxH, eh[i]);
+        maxDelta = std::max(maxDelta, std::fabs(baseDelta * direction * enemies.speed[i]));
+    }
+    // Filas de la altura máxima: un rect sólo puede solapar a enemigos de su fila o las vecinas
+    const float rowH = std::max(maxH, 1.0f);
+    sweep.clear();
+    for (size_t i = 0; i < n; ++i) {
+        if (alive[i]) sweep.push_back({ (int)std::floor(ey[i] / rowH), ex[i], (uint32_t)i });
+    }
+    auto byRowX = [](const SweepEntry& a, const SweepEntry& b) {
+        return a.row != b.row ? a.row < b.row : a.x < b.x;
+    };
+    std::sort(sweep.begin(), sweep.end(), byRowX);
+
+    for (size_t i = 0; i < n; ++i) {
+        if (!alive[i]) continue;
+        float delta = baseDelta * direction * enemies.speed[i]; // usa speed del enemigo
+        const float px = ex[i] + delta;
+        const float py = ey[i];
 
-            if (placed) {
-                std::cout << "[EnemyManager] Boss teleported to x=" << e.rect.x << "\n";
-            } else {
-                std::cout << "[EnemyManager] Boss teleport requested but no free spot found\n";
+        // j solapa si ey[j] está en (py - eh[j], py + eh[i]) y ex[j] en (px - ew[j], px + ew[i])
+        // (con 1px de margen para que el redondeo no deje fuera a un vecino en el límite)
+        const int rowLo = (int)std::floor((py - maxH - 1.0f) / rowH);
+        const int rowHi = (int)std::floor((py + eh[i] + 1.0f) / rowH);
+        const float xLo = px - maxW - maxDelta - 1.0f;
+        const float xHi = px + ew[i] + maxDelta + 1.0f;
+        bool collision = false;
+        for (int row = rowLo; row <= rowHi && !collision; ++row) {
+            auto it = std::lower_bound(sweep.begin(), sweep.end(), SweepEntry{ row, xLo, 0 }, byRowX);
+            for (; it != sweep.end() && it->row == row && it->x < xHi; ++it) {
+                const size_t j = it->index;
+                if (j == i) continue;
+                if (px < ex[j] + ew[j] && px + ew[i] > ex[j] && py < ey[j] + eh[j] && py + eh[i] > ey[j]) { collision = true; break; }
             }
-            // Reset request
-            e.wantsTeleport = false;
-            e.pendingTeleportX = -1.0f;
         }
 
-        // Si el enemigo cruza la parte inferior de la ventana, avisar para que CollisionManager gestione la pérdida de vida
-        const float screenH = 600.0f; // altura de ventana
-        if (e.alive && (e.rect.y + e.rect.h >= screenH)) {
-            // No marcamos e.alive = false aquí para que CollisionManager pueda detectarlo y restar la vida
-            std::cout << "[EnemyManager] Enemy reached bottom at x=" << e.rect.x << " y=" << e.rect.y << ". CollisionManager will handle life loss." << std::endl;
+        // Si no colisiona con otro enemigo, aplicar movimiento
+        if (!collision) {
+            ex[i] = px;
         }
+        // Si collision=true, dejamos al enemigo en su lugar (evita solapamiento)
     }
 }
 
-void EnemyManager::FireRandomBullet(std::vector<Bullet>& enemyBullets) {
+void EnemyManager::ResolveTeleport(size_t i) {
+    EnemyCold& c = enemies.cold[i];
+    const float screenW = 800.0f;
+    const float ew = enemies.w[i];
+    const float eh = enemies.h[i];
+    const float ey = enemies.y[i];
+    float targetX = c.pendingTeleportX;
+    if (targetX < 0.0f) targetX = enemies.x[i];
+    SDL_FRect cand = { targetX, ey, ew, eh };
+
+    auto overlapsAny = [&](const SDL_FRect& r) {
+        // comprobar con otros enemigos (en lote; el propio boss no cuenta)
+        const RectSoA rects = enemies.Rects();
+        size_t j = FirstOverlap(r, rects);
+        if (j == i) j = FirstOverlap(r, rects, i + 1);
+        if (j < rects.n) return true;
+        // comprobar con bloques defensivos
+        for (auto& b : defenseBlocks) {
+            if (!b.alive) continue;
+            if (RectsOverlap(r, b.rect)) return true;
+        }
+        return false;
+    };
+
+    bool placed = false;
+    if (!overlapsAny(cand)) {
+        enemies.x[i] = cand.x;
+        placed = true;
+    } else {
+        // buscar huecos a izquierda/derecha
+        for (int off = 16; off <= 240 && !placed; off += 16) {
+            float lx = targetX - off;
+            float rx = targetX + off;
+            if (lx >= 0.0f) {
+                SDL_FRect r2 = { lx, ey, ew, eh };
+                if (!overlapsAny(r2)) { enemies.x[i] = lx; placed = true; break; }
+            }
+            if (rx + ew <= screenW) {
+                SDL_FRect r3 = { rx, ey, ew, eh };
+                if (!overlapsAny(r3)) { enemies.x[i] = rx; placed = true; break; }
+            }
+        }
+    }
+
+    if (placed) {
+        // Teletransporte: no interpolar desde la posición anterior
+        enemies.prevX[i] = enemies.x[i];
+        LOG_DEBUG(Enemies, "Boss teleported to x=" << enemies.x[i]);
+    } else {
+        LOG_DEBUG(Enemies, "Boss teleport requested but no free spot found");
+    }
+    // Reset request
+    c.wantsTeleport = false;
+    c.pendingTeleportX = -1.0f;
+}
+
+void EnemyManager::FireRandomBullet(BulletArray& enemyBullets, int shooters) {
     // Primero verificar si algún boss ha solicitado triple shot
-    for (auto& enemy : enemies) {
-        if (!enemy.alive) continue;
-        if (enemy.isBoss && enemy.bossAction == Enemy::BossAction::TripleShot && enemy.actionTimer > 0.0f) {
-            float bulletX = enemy.rect.x + enemy.rect.w / 2 - 2.5f;
-            float bulletY = enemy.rect.y + enemy.rect.h;
+    const uint32_t boss = shooterIndex.TripleShotBoss();
+    if (boss != ShooterIndex::None && enemies.alive[boss]) {
+        EnemyCold& c = enemies.cold[boss];
+        if (c.bossAction == BossAction::TripleShot && c.actionTimer > 0.0f) {
+            float bulletX = enemies.x[boss] + enemies.w[boss] / 2 - 2.5f;
+            float bulletY = enemies.y[boss] + enemies.h[boss];
             // Tres balas con diferente velocidad horizontal
-            enemyBullets.emplace_back(bulletX, bulletY, 220.0f, -120.0f);
-            enemyBullets.emplace_back(bulletX, bulletY, 220.0f, 0.0f);
-            enemyBullets.emplace_back(bulletX, bulletY, 220.0f, 120.0f);
+            enemyBullets.Spawn(bulletX, bulletY, 220.0f, -120.0f, false, -1.0f, -1.0f, BulletOwner::Enemy);
+            enemyBullets.Spawn(bulletX, bulletY, 220.0f, 0.0f, false, -1.0f, -1.0f, BulletOwner::Enemy);
+            enemyBullets.Spawn(bulletX, bulletY, 220.0f, 120.0f, false, -1.0f, -1.0f, BulletOwner::Enemy);
             // Consumir la acción
-            enemy.bossAction = Enemy::BossAction::None;
-            enemy.actionTimer = 0.0f;
+            c.bossAction = BossAction::None;
+            c.actionTimer = 0.0f;
             return;
         }
     }
 
-    // Buscar enemigos vivos en la fila inferior
-    std::vector<Enemy*> bottomEnemies;
-    for (auto& enemy : enemies) {
-        if (!enemy.alive) continue;
-        
-        bool isBottom = true;
-        for (auto& other : enemies) {
-            if (!other.alive) continue;
-            if (abs(other.rect.x - enemy.rect.x) < 30 && other.rect.y > enemy.rect.y) {
-                isBottom = false;
-                break;
-            }
-        }
-        if (isBottom) {
-            bottomEnemies.push_back(&enemy);
-        }
+    // Disparar desde enemigos aleatorios de la fila inferior
+    shooterIndex.Pick(enemies, shooters, rng.enemyFire, volley);
+    for (uint32_t shooter : volley) {
+        float bulletX = enemies.x[shooter] + enemies.w[shooter] / 2 - 2.5f;
+        float bulletY = enemies.y[shooter] + enemies.h[shooter];
+        enemyBullets.Spawn(bulletX, bulletY, 200.0f, 0.0f, false, -1.0f, -1.0f, BulletOwner::Enemy); // Velocidad hacia abajo
     }
-    
-    // Disparar desde un enemigo aleatorio de la fila inferior
-    if (!bottomEnemies.empty()) {
-        int randomIndex = rand() % bottomEnemies.size();
-        Enemy* shooter = bottomEnemies[randomIndex];
-        float bulletX = shooter->rect.x + shooter->rect.w / 2 - 2.5f;
-        float bulletY = shooter->rect.y + shooter->rect.h;
-        enemyBullets.emplace_back(bulletX, bulletY, 200.0f); // Velocidad hacia abajo
+}
+
+void EnemyManager::SaveState(StateWriter& w) const {
+    w.Put(direction); w.Put(speed); w.Put(dropTimer); w.Put(moveTimer); w.Put(shootTimer);
+    enemies.SaveState(w);
+    w.Put<uint32_t>((uint32_t)defenseBlocks.size());
+    for (const auto& b : defenseBlocks) b.SaveState(w);
+}
+
+bool EnemyManager::RestoreState(StateReader& r) {
+    r.Get(direction); r.Get(speed); r.Get(dropTimer); r.Get(moveTimer); r.Get(shootTimer);
+    if (!enemies.RestoreState(r)) return false;
+    shooterIndex.Rebuild(enemies);
+    // Los edificios se crean una vez y persisten entre niveles: el snapshot debe tener los mismos
+    uint32_t n = 0;
+    if (!r.Get(n) || n != defenseBlocks.size()) return false;
+    for (auto& b : defenseBlocks) {
+        if (!b.RestoreState(r)) return false;
     }
+    return r.Ok();
 }
 
-void EnemyManager::Render(SDL_Renderer* renderer, SDL_Texture* enemyTexture, SpriteSheet* sheet) {
-    // Render enemies using texture if provided
-    for (auto& e : enemies) {
-        if (!e.alive) continue;
+void EnemyManager::Render(SpriteBatch& batch, SDL_Texture* enemyTexture, SpriteSheet* sheet, float alpha) {
+    // Render enemies using texture if provided (se encolan en el lote; Game hace el Flush)
+    const SDL_Color bossOutline = {255, 255, 0, 255};
+    for (size_t i = 0; i < enemies.Size(); ++i) {
+        if (!enemies.alive[i]) continue;
+        SDL_FRect er = enemies.RenderRect(i, alpha);
+        const EnemyType type = enemies.type[i];
         if (sheet) {
             // Use sprite sheet for enemies. Map type Basic -> index 9.
             int idx = 9; // default for basic
             // Optionally set different indices for other enemy types
-            if (e.type == EnemyType::Basic) idx = 9;
-            else if (e.type == EnemyType::Fast) idx = 8; // example
-            else if (e.type == EnemyType::Tank) idx = 7; // example
+            if (type == EnemyType::Basic) idx = 9;
+            else if (type == EnemyType::Fast) idx = 8; // example
+            else if (type == EnemyType::Tank) idx = 7; // example
 
             SDL_Rect src = sheet->GetSrcRect(idx);
             const int scale = 5; // x5 -> 40x40
-            SDL_FRect dst = { e.rect.x, e.rect.y, (float)(sheet->TileW() * scale), (float)(sheet->TileH() * scale) };
+            SDL_FRect dst = { er.x, er.y, (float)(sheet->TileW() * scale), (float)(sheet->TileH() * scale) };
             // center within e.rect if sizes differ and snap to integer pixels
-            float cx = e.rect.x + (e.rect.w - dst.w) / 2.0f;
-            float cy = e.rect.y + (e.rect.h - dst.h) / 2.0f;
+            float cx = er.x + (er.w - dst.w) / 2.0f;
+            float cy = er.y + (er.h - dst.h) / 2.0f;
             dst.x = (float)std::round(cx);
             dst.y = (float)std::round(cy);
             SDL_FRect srcF = {(float)src.x, (float)src.y, (float)src.w, (float)src.h};
-            SDL_RenderTexture(renderer, sheet->GetTexture(), &srcF, &dst);
-            if (e.isBoss) {
-                SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
-                SDL_FRect outline = { e.rect.x - 2.0f, e.rect.y - 2.0f, e.rect.w + 4.0f, e.rect.h + 4.0f };
-                SDL_RenderRect(renderer, &outline);
+            batch.Draw(sheet->GetTexture(), &srcF, dst);
+            if (type == EnemyType::Boss) {
+                SDL_FRect outline = { er.x - 2.0f, er.y - 2.0f, er.w + 4.0f, er.h + 4.0f };
+                batch.OutlineRect(outline, bossOutline);
             }
         } else if (enemyTexture) {
-            // Render texture to enemy.rect — use integer dst because SDL_RenderCopyF may not be
-            // available in all SDL3 builds. Falls back to integer rect rendering.
-            SDL_FRect dstF = e.rect;
-            SDL_RenderTexture(renderer, enemyTexture, nullptr, &dstF);
-            if (e.isBoss) {
-                SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
-                SDL_FRect outline = { e.rect.x - 2.0f, e.rect.y - 2.0f, e.rect.w + 4.0f, e.rect.h + 4.0f };
-                SDL_RenderRect(renderer, &outline);
+            // Textura entera estirada al rect del enemigo
+            batch.Draw(enemyTexture, nullptr, er);
+            if (type == EnemyType::Boss) {
+                SDL_FRect outline = { er.x - 2.0f, er.y - 2.0f, er.w + 4.0f, er.h + 4.0f };
+                batch.OutlineRect(outline, bossOutline);
             }
         } else {
-            e.Render(renderer);
+            enemies.RenderFallback(batch, i, alpha);
         }
     }
 
@@ -1,27 +1,56 @@
 #pragma once
 #include <vector>
 #include "Enemy.h"
+#include "ShooterIndex.h"
 #include "Bullet.h"
 #include "Skyscraper.h"
 #include "SpriteSheet.h"
+#include "SpriteBatch.h"
+#include "Rng.h"
+#include "GameState.h"
 
 class EnemyManager {
 public:
-    EnemyManager();
+    // rng: streams de la partida (propiedad de Game); se usan enemies y enemyFire
+    explicit EnemyManager(GameRng& rng);
     void Update(float dt);
     // Optionally provide a SpriteSheet to draw enemies from. If sheet==nullptr, falls back
     // to using enemyTexture or simple rects.
-    void Render(SDL_Renderer* renderer, SDL_Texture* enemyTexture, SpriteSheet* sheet = nullptr);
+    // alpha: interpolación entre el paso de simulación anterior y el actual
+    void Render(SpriteBatch& batch, SDL_Texture* enemyTexture, SpriteSheet* sheet = nullptr, float alpha = 1.0f);
     // Render background elements (skyscrapers) so they draw behind bullets/player
     void RenderBackground(SDL_Renderer* renderer);
-    void FireRandomBullet(std::vector<Bullet>& enemyBullets);
-    std::vector<Enemy> enemies;
+    // Edificios de defensa: uno por columna, imagen assets/sprites/build_NN.png
+    // (Game::Init las precarga en AssetCache)
+    static constexpr int kBuildingColumns = 6;
+    static std::string BuildingImagePath(int column);
+    // Disparo enemigo: triple disparo del boss que lo tenga pendiente o, si no, una volea de
+    // `shooters` enemigos distintos de la fila inferior elegidos al azar
+    void FireRandomBullet(BulletArray& enemyBullets, int shooters = 1);
+    // CollisionManager avisa de las bajas y altas de enemigos (índice de tiradores)
+    void OnEnemyDied(uint32_t i) { shooterIndex.OnDeath(i); }
+    void OnEnemySpawned(uint32_t i) { shooterIndex.OnSpawn(enemies, i); }
+    EnemyArray enemies;
     std::vector<Skyscraper> defenseBlocks;
     void LoadLevel(int levelIndex = 0);
+    // Snapshot (Game::SaveState): timers de formación, enemigos y edificios
+    void SaveState(StateWriter& w) const;
+    bool RestoreState(StateReader& r);
 private:
+    // Boss i pidió teletransporte: buscar un hueco libre cerca del destino
+    void ResolveTeleport(size_t i);
+    // Paso horizontal de la formación sin solapes (sort-and-sweep por filas)
+    void MoveFormationStep();
+    GameRng& rng;
     float direction = 1.0f; // 1 = derecha, -1 = izquierda
     float speed = 150.0f;   // Aumentado de 50 a 150
     float dropTimer = 0.0f;
     float moveTimer = 0.0f;
     float shootTimer = 0.0f;
+    // Tiradores de la fila inferior (incremental, ver ShooterIndex) y volea elegida en FireRandomBullet
+    ShooterIndex shooterIndex;
+    std::vector<uint32_t> volley;
+    // Enemigos vivos ordenados por (fila, x) para MoveFormationStep
+    struct SweepEntry { int row; float x; uint32_t index; };
+    std::vector<SweepEntry> sweep;
 };
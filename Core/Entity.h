@@ -4,6 +4,17 @@ class Entity {
 public:
     virtual ~Entity() {}
     virtual void Update(float dt) = 0;
-    virtual void Render(SDL_Renderer* renderer) = 0;
+    // alpha: fracción [0,1] entre el paso de simulación anterior y el actual (interpolación de render)
+    virtual void Render(SDL_Renderer* renderer, float alpha = 1.0f) = 0;
     SDL_FRect rect;
+    // Rect al inicio del último paso de simulación (Game::Step lo guarda antes de mover)
+    SDL_FRect prevRect;
+
+    void SavePrevRect() { prevRect = rect; }
+    // Posición interpolada entre prevRect y rect para dibujar entre dos pasos fijos
+    SDL_FRect RenderRect(float alpha) const {
+        return { prevRect.x + (rect.x - prevRect.x) * alpha,
+                 prevRect.y + (rect.y - prevRect.y) * alpha,
+                 rect.w, rect.h };
+    }
 };
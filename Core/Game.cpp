@@ -2,15 +2,22 @@
 #include <SDL3/SDL.h>
 #include "HumanController.h"
 #include "../tools/ai/AIController.h"
+#include "Replay.h"
+#include "Profiler.h"
+#include "Log.h"
+#include "AssetCache.h"
+#ifndef SPACEINVADERS_SIM_ONLY
+#include "Renderer.h"
+#include "TextRenderer.h"
+#endif
 
 #include <cmath>
-#include <iostream>
 #include <vector>
 #include <algorithm>
-#include <chrono>
 #include <fstream>
 #include "../libs/nlohmann/json.hpp"
 #include <filesystem>
+#include <cstring>
 using json = nlohmann::json;
 
 // Evitar conflicto con macro max de Windows
@@ -18,15 +25,15 @@ using json = nlohmann::json;
 #undef max
 #endif
 
+#ifndef SPACEINVADERS_SIM_ONLY
 #include "AudioManagerMiniaudio.h"
+#endif
 
 // Evitar conflicto con macro DrawText de Windows
 #ifdef DrawText
 #undef DrawText
 #endif
 
-bool g_running = true;
-
 int Game::GetCurrentLevel() const { return currentLevel; }
 
 Game::Game() : running(false), player(nullptr), enemyManager(nullptr), renderer(nullptr), inputManager(nullptr), collisionManager(nullptr), particleSystem(nullptr), textRenderer(nullptr), audioManager(nullptr), score(0), lives(3), gameOver(false), gameWon(false), enemyShootTimer(0.0f) {}
@@ -36,136 +43,274 @@ float Game::GetPlayerFireCooldown() const { return playerFireCooldown; }
 void Game::ActivateContinueFire(float seconds) {
     // Reduce fire cooldown to a faster rate for "continue fire" powerup
     continueFireTimer = std::max(continueFireTimer, seconds);
-    std::cout << "[Game] ContinueFire activated: " << continueFireTimer << "s" << std::endl;
+    LOG_INFO(Game, "ContinueFire activated: " << continueFireTimer << "s");
 }
 
 Game::~Game() { Shutdown(); }
 
-bool Game::Init() {
-    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
-        SDL_Log("No se pudo inicializar SDL: %s", SDL_GetError());
-        return false;
-    }
-    renderer = new Renderer();
-    if (!renderer->Init()) {
-        SDL_Log("No se pudo crear ventana o renderer");
-        return false;
-    }
-    // Iniciar cronómetro de la partida
-    startTime = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
-    player = new Player();
-    // Decidir controlador: por defecto humano, pero si la línea de comandos pide autoplay
-    bool autoplay = false;
-    bool headless = false;
-    unsigned int seed = 0;
-    // Uso de variables globales de argc/argv (están disponibles en MSVC/GCC como __argc/__argv)
-    for (int i = 0; i < __argc; ++i) {
-        const char* a = __argv[i];
-        if (a == nullptr) continue;
-        std::string s(a);
-        if (s == "--autoplay") autoplay = true;
-        if (s == "--headless") headless = true;
-        if (s == std::string("--seed") && i+1 < __argc) {
-        seed = static_cast<unsigned int>(std::stoul(__argv[i+1]));
-        }
+bool Game::Init(const GameConfig& cfg) {
+    // La configuración llega ya parseada (main.cpp o SimulationRunner): en headless no se crea ventana
+    config = cfg;
+    if (cfg.powerUpCapacity != powerUps.Capacity()) powerUps = PowerUpPool(cfg.powerUpCapacity);
+    bool autoplay = cfg.autoplay;
+    bool headless = cfg.headless;
+    unsigned int seed = cfg.seed;
+    if (!cfg.replayPath.empty()) {
+        // Reproducción: la semilla y toda la entrada salen del fichero; no se crea controlador
+        replayPlayback = new Replay();
+        if (!replayPlayback->Load(cfg.replayPath)) return false;
+        seed = replayPlayback->seed;
+        // No pisar el log/historial de la partida original
+        config.writeHistory = false;
+        LOG_INFO(Replay, "Playing " << cfg.replayPath << ": seed " << seed << ", "
+                 << replayPlayback->TickCount() << " ticks");
+    } else if (!cfg.recordPath.empty()) {
+        replayRecord = new Replay();
+        replayRecord->seed = seed;
     }
+    // Profiler por fases: las muestras se vuelcan a cfg.tracePath al terminar Run
+    if (!cfg.tracePath.empty()) Profiler::Get().Enable();
+#ifdef SPACEINVADERS_SIM_ONLY
+    // El build de simulación no enlaza renderer, TTF ni audio: siempre headless
+    headless = true;
+#endif
     // store seed for logging
     runSeed = static_cast<int>(seed);
+    // Toda la aleatoriedad de la simulación sale de aquí: misma semilla -> misma partida
+    rng.Seed(seed);
     autoplayEnabled = autoplay;
     headlessEnabled = headless;
+
+    // Decodificar las imágenes en hilos de trabajo mientras se crea la ventana: los edificios
+    // y el Renderer las recogen ya decodificadas (y una sola vez por proceso)
+    std::vector<std::string> images;
+    for (int i = 0; i < EnemyManager::kBuildingColumns; ++i) images.push_back(EnemyManager::BuildingImagePath(i));
+#ifndef SPACEINVADERS_SIM_ONLY
+    if (!headless) {
+        const std::vector<std::string> rendererImages = Renderer::AssetPaths();
+        images.insert(images.end(), rendererImages.begin(), rendererImages.end());
+    }
+#endif
+    AssetCache::Get().Preload(images);
+
+#ifndef SPACEINVADERS_SIM_ONLY
+    if (!headless) {
+        if (!SDL_Init(SDL_INIT_VIDEO)) {
+            SDL_Log("No se pudo inicializar SDL: %s", SDL_GetError());
+            return false;
+        }
+        renderer = new Renderer();
+        if (!renderer->Init()) {
+            SDL_Log("No se pudo crear ventana o renderer");
+            return false;
+        }
+    }
+#endif
+    // Iniciar cronómetro de la partida (tiempo simulado)
+    simTime = 0.0;
+    player = new Player();
     // Crear InputManager
-    enemyManager = new EnemyManager();
+    enemyManager = new EnemyManager(rng);
     inputManager = new InputManager();
     // Crear y asignar el controlador apropiado
-    if (autoplay) {
+    if (replayPlayback) {
+        // Sin controlador: Step toma la entrada de la cinta
+    } else if (autoplay) {
         // IA de pruebas en tools/ai
-        tools::ai::AIController* ai = new tools::ai::AIController(seed);
+        tools::ai::AIController* ai = new tools::ai::AIController(seed, cfg.ai);
         player->SetController(ai);
     } else {
         HumanController* humanCtrl = new HumanController(inputManager);
         player->SetController(humanCtrl);
     }
 
-    // Usar sistema de audio miniaudio
-    audioManager = new AudioManagerMiniaudio();
-    if (!audioManager->Initialize()) {
-        SDL_Log("Error al inicializar el sistema de audio (miniaudio)");
-        return false;
+#ifndef SPACEINVADERS_SIM_ONLY
+    if (!headless) {
+        // Usar sistema de audio miniaudio
+        audioManager = new AudioManagerMiniaudio();
+        if (!audioManager->Initialize()) {
+            SDL_Log("Error al inicializar el sistema de audio (miniaudio)");
+            return false;
+        }
+        // Cargar sonidos desde assets
+        audioManager->LoadSound("player_shoot", "assets/player_shoot.wav");
+        audioManager->LoadSound("enemy_explosion", "assets/enemy_explosion.wav");
+        audioManager->LoadSound("player_death", "assets/player_death.wav");
     }
-    // Cargar sonidos desde assets
-    audioManager->LoadSound("player_shoot", "assets/player_shoot.wav");
-    audioManager->LoadSound("enemy_explosion", "assets/enemy_explosion.wav");
-    audioManager->LoadSound("player_death", "assets/player_death.wav");
-    
+#endif
+
+    // audioManager puede ser nullptr (headless): CollisionManager lo comprueba antes de cada sonido
     collisionManager = new CollisionManager(audioManager);
-    particleSystem = new ParticleSystem();
-    textRenderer = new TextRenderer();
-    
-    if (!textRenderer->Init()) {
-        std::cout << "Warning: No se pudo inicializar TextRenderer" << std::endl;
+    particleSystem = new ParticleSystem(rng.particles);
+
+#ifndef SPACEINVADERS_SIM_ONLY
+    if (!headless) {
+        textRenderer = new TextRenderer();
+        if (!textRenderer->Init()) {
+            LOG_WARN(Game, "No se pudo inicializar TextRenderer");
+        }
     }
+#endif
     
     // Desactivar modo test de powerups por defecto (no sueltan todos los enemigos)
     SetPowerupTestMode(false);
 
     running = true;
-    g_running = true;
     return true;
 }
 
-// Dibuja un círculo relleno en SDL
-void DrawCircle(SDL_Renderer* rend, int cx, int cy, int radius, SDL_Color color) {
-    // Guardar blend mode actual si es posible
+#ifndef SPACEINVADERS_SIM_ONLY
+// Dibuja un círculo relleno en SDL: una franja por fila (geometría cacheada por radio en el
+// lote del Renderer) y una sola SDL_RenderGeometry, en vez de un SDL_RenderPoint por píxel
+void DrawCircle(Renderer* renderer, int cx, int cy, int radius, SDL_Color color) {
     // SDL_BlendMode no tiene getter en SDL2/3, así que asumimos que el renderer ya
-    // tiene blending activado (se estableció en Renderer::Init)
-    SDL_SetRenderDrawColor(rend, color.r, color.g, color.b, color.a);
-    for (int w = -radius; w <= radius; w++) {
-        for (int h = -radius; h <= radius; h++) {
-            if (w * w + h * h <= radius * radius) {
-                // SDL_RenderPoint respeta el color con alpha cuando el blend mode está activo
-                SDL_RenderPoint(rend, cx + w, cy + h);
-            }
-        }
-    }
+    // tiene blending activado (se estableció en Renderer::Init); los vértices llevan el alfa
+    SpriteBatch& batch = renderer->GetBatch();
+    batch.FillCircle(cx, cy, radius, color);
+    batch.Flush(renderer->GetSDLRenderer());
 }
+#endif
 
 void Game::Run() {
-    SDL_Renderer* rend = renderer->GetSDLRenderer();
+    if (headlessEnabled) {
+        // Sin ventana, sin eventos y sin espera: simular tan rápido como permita la CPU.
+        // La partida termina cuando SaveGameHistoryEntry detiene el bucle (fin de nivel o game over).
+        while (running) {
+            PROFILE_SCOPE("step");
+            StepCounted(FixedStep);
+        }
+        FinishReplay();
+        FinishTrace();
+        FinishAllocStats();
+        FinishPoolStats();
+        Logger::Get().Flush();
+        return;
+    }
+
+#ifndef SPACEINVADERS_SIM_ONLY
     SDL_Event e;
+    // Acumulador de paso fijo: la simulación avanza siempre en pasos de FixedStep,
+    // independientemente de lo que tarde el render; el sobrante se usa para interpolar.
+    const double freq = (double)SDL_GetPerformanceFrequency();
+    Uint64 lastCounter = SDL_GetPerformanceCounter();
+    double accumulator = 0.0;
     while (running) {
+        PROFILE_SCOPE("frame");
+        Uint64 nowCounter = SDL_GetPerformanceCounter();
+        double frameTime = (double)(nowCounter - lastCounter) / freq;
+        lastCounter = nowCounter;
+        // Limitar frames muy largos (breakpoints, arrastrar la ventana...)
+        if (frameTime > 0.25) frameTime = 0.25;
+        // Reproducción con ventana a velocidad ajustable (--replay-speed)
+        const double speed = replayPlayback ? (double)config.replaySpeed : 1.0;
+        accumulator += frameTime * speed;
+        const int maxSteps = MaxCatchUpSteps * (int)std::ceil(speed);
+
         // Limpiar estado de input del frame anterior
         inputManager->Update();
         
         // Gestionar eventos de ventana Y pasarlos al InputManager
-        while (SDL_PollEvent(&e)) {
-            if (e.type == SDL_EVENT_QUIT) running = false;
-            if (e.type == SDL_EVENT_KEY_DOWN && e.key.key == SDLK_ESCAPE) running = false;
-                // Si estamos en transición de nivel, cualquier tecla avanza
-                if (levelTransition && e.type == SDL_EVENT_KEY_DOWN) {
-                    levelTransition = false;
-                    NextLevel();
-                }
-            // Pasar el evento al InputManager para procesamiento
-            inputManager->HandleEvent(e);
+        {
+            PROFILE_SCOPE("events");
+            while (SDL_PollEvent(&e)) {
+                if (e.type == SDL_EVENT_QUIT) running = false;
+                if (e.type == SDL_EVENT_KEY_DOWN && e.key.key == SDLK_ESCAPE) running = false;
+                    // Si estamos en transición de nivel, cualquier tecla avanza (en replay lo decide la cinta)
+                    if (levelTransition && !replayPlayback && e.type == SDL_EVENT_KEY_DOWN) {
+                        levelTransition = false;
+                        NextLevel();
+                        pendingAdvance = true;
+                    }
+                // Pasar el evento al InputManager para procesamiento
+                inputManager->HandleEvent(e);
+            }
         }
-        
-        // dt real del frame (puedes sustituir por un timer real si tienes uno)
-        const float realDt = 0.016f;
-        // timeScale reduzca todo excepto el jugador
-        float timeScale = (bulletTimeTimer > 0.0f) ? 0.35f : 1.0f;
-        float scaledDt = realDt * timeScale;
-
-        // Control: si el player tiene un controller (HumanController o AIController) usamos sus queries
-            // Construir una observación del mundo para controladores (IA)
-            IPlayerController* ctrl = player->GetController();
-            WorldObservation obs;
+
+        int steps = 0;
+        while (accumulator >= FixedStep && steps < maxSteps && running) {
+            PROFILE_SCOPE("step");
+            StepCounted(FixedStep);
+            accumulator -= FixedStep;
+            steps++;
+        }
+        // Si no se ha podido recuperar el retraso, descartarlo en lugar de acumularlo
+        if (steps == maxSteps && accumulator >= FixedStep) accumulator = 0.0;
+
+        {
+            PROFILE_SCOPE("render");
+            RenderFrame((float)(accumulator / FixedStep));
+        }
+        {
+            PROFILE_SCOPE("present");
+            renderer->Present();
+        }
+        // Sin frame listo todavía: ceder CPU en lugar de girar en vacío (VSync suele marcar el ritmo)
+        if (steps == 0) SDL_Delay(1);
+    }
+    FinishReplay();
+    FinishTrace();
+    FinishAllocStats();
+    FinishPoolStats();
+    Logger::Get().Flush();
+#endif
+}
+
+void Game::Step(float realDt) {
+    // Reproducción: entrada de este tick desde la cinta
+    uint8_t tapeInput = 0;
+    if (replayPlayback) {
+        if (replayFinished) return;
+        if (!replayPlayback->Next(tapeInput)) {
+            replayFinished = true;
+            VerifyReplay();
+            // En headless se termina; con ventana se queda mostrando el estado final
+            if (headlessEnabled) running = false;
+            return;
+        }
+        if ((tapeInput & Replay::Advance) && levelTransition) NextLevel();
+    }
+    simTime += realDt;
+    // Corte de seguridad para runs automáticos (p.ej. la IA queda atascada sin terminar el nivel)
+    if (config.maxSimSeconds > 0.0 && simTime >= config.maxSimSeconds) {
+        timedOut = true;
+        elapsedTime = simTime;
+        SaveGameHistoryEntry();
+        running = false;
+        return;
+    }
+    // Guardar posiciones de partida del paso para la interpolación del render
+    player->SavePrevRect();
+    enemyManager->enemies.SavePrevRects();
+    bullets.SavePrevRects();
+    enemyBullets.SavePrevRects();
+    for (auto& pu : powerUps) pu.SavePrevRect();
+    // timeScale reduzca todo excepto el jugador
+    float timeScale = (bulletTimeTimer > 0.0f) ? 0.35f : 1.0f;
+    float scaledDt = realDt * timeScale;
+
+    // Entrada de este tick (bits de Replay): cinta de replay, controller (HumanController o
+    // AIController) o teclado. Se muestrea una sola vez y se graba si hay --record.
+    uint8_t input = 0;
+    IPlayerController* ctrl = player->GetController();
+    if (replayPlayback) {
+        input = tapeInput & (Replay::Left | Replay::Right | Replay::Fire);
+    } else if (ctrl) {
+        // Construir una observación del mundo para controladores (IA). Es un miembro para
+        // que sus vectores conserven la capacidad entre pasos
+        WorldObservation& obs = observation;
+        obs.enemies.clear();
+        obs.powerups.clear();
+        obs.enemyBullets.clear();
+        {
+            PROFILE_SCOPE("observe");
             // Llenar posición del jugador
-        obs.playerX = player->rect.x + player->rect.w / 2.0f;
-        obs.playerY = player->rect.y + player->rect.h / 2.0f;
+            obs.playerX = player->rect.x + player->rect.w / 2.0f;
+            obs.playerY = player->rect.y + player->rect.h / 2.0f;
             // Enemigos
-            for (const auto& e : enemyManager->enemies) {
-                if (!e.alive) continue;
-                EnemyInfo ei{ e.rect.x + e.rect.w/2.0f, e.rect.y + e.rect.h/2.0f, e.health, static_cast<int>(e.type) };
+            const EnemyArray& foes = enemyManager->enemies;
+            for (size_t i = 0; i < foes.Size(); ++i) {
+                if (!foes.alive[i]) continue;
+                EnemyInfo ei{ foes.x[i] + foes.w[i]/2.0f, foes.y[i] + foes.h[i]/2.0f, foes.health[i], static_cast<int>(foes.type[i]) };
                 obs.enemies.push_back(ei);
             }
             // Powerups
@@ -175,337 +320,371 @@ void Game::Run() {
                 obs.powerups.push_back(pi);
             }
             // Enemy bullets for evasion
-            for (const auto& bullet : enemyBullets) {
-                if (!bullet.active) continue;
-                BulletInfo bi{ bullet.rect.x + bullet.rect.w/2.0f, bullet.rect.y + bullet.rect.h/2.0f, bullet.vx, bullet.speed };
+            for (uint32_t i : enemyBullets.Live()) {
+                if (!enemyBullets.IsActive(i)) continue;
+                BulletInfo bi{ enemyBullets.x[i] + enemyBullets.w[i]/2.0f, enemyBullets.y[i] + enemyBullets.h[i]/2.0f, enemyBullets.vx[i], enemyBullets.vy[i] };
                 obs.enemyBullets.push_back(bi);
             }
+        }
+        PROFILE_SCOPE("controller");
+        ctrl->Observe(obs);
+        if (ctrl->WantsMoveLeft()) input |= Replay::Left;
+        if (ctrl->WantsMoveRight()) input |= Replay::Right;
+        if (ctrl->WantsFire()) input |= Replay::Fire;
+    } else {
+        if (inputManager->IsLeftPressed()) input |= Replay::Left;
+        if (inputManager->IsRightPressed()) input |= Replay::Right;
+        if (inputManager->IsFirePressed()) input |= Replay::Fire;
+    }
+    if (replayRecord) replayRecord->Push(input | (pendingAdvance ? Replay::Advance : 0));
+    pendingAdvance = false;
+    lastInput = input;
 
-            if (ctrl) {
-                ctrl->Observe(obs);
-                if (ctrl->WantsMoveLeft()) player->Move(-1.0f, realDt);
-                if (ctrl->WantsMoveRight()) player->Move(1.0f, realDt);
-            } else {
-                if (inputManager->IsLeftPressed()) player->Move(-1.0f, realDt);
-                if (inputManager->IsRightPressed()) player->Move(1.0f, realDt);
-            }
-            // Track movement to compute idle time
-            double now = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
-            float px = player->rect.x;
-            if (lastPlayerX < 0.0f) {
+    if (input & Replay::Left) player->Move(-1.0f, realDt);
+    if (input & Replay::Right) player->Move(1.0f, realDt);
+        // Track movement to compute idle time
+        double now = simTime;
+        float px = player->rect.x;
+        if (lastPlayerX < 0.0f) {
+            lastPlayerX = px;
+            lastMoveTimestamp = now;
+        } else {
+            if (fabs(px - lastPlayerX) > 1.0f) {
+                // Considered as movement
                 lastPlayerX = px;
                 lastMoveTimestamp = now;
             } else {
-                if (fabs(px - lastPlayerX) > 1.0f) {
-                    // Considered as movement
-                    lastPlayerX = px;
-                    lastMoveTimestamp = now;
-                } else {
-                    // if hasn't moved for >0.5s, count as idle
-                    if (now - lastMoveTimestamp > 0.5) {
-                        timeIdle += realDt;
-                    }
+                // if hasn't moved for >0.5s, count as idle
+                if (now - lastMoveTimestamp > 0.5) {
+                    timeIdle += realDt;
                 }
             }
-        // Decrementar timers relacionados con disparo y powerup ContinueFire
-        // playerFireTimer evita disparos a velocidad infinita cuando se mantiene el botón
-        playerFireTimer -= realDt;
-        if (continueFireTimer > 0.0f) {
-            continueFireTimer -= realDt;
-            if (continueFireTimer < 0.0f) continueFireTimer = 0.0f;
         }
+    // Decrementar timers relacionados con disparo y powerup ContinueFire
+    // playerFireTimer evita disparos a velocidad infinita cuando se mantiene el botón
+    playerFireTimer -= realDt;
+    if (continueFireTimer > 0.0f) {
+        continueFireTimer -= realDt;
+        if (continueFireTimer < 0.0f) continueFireTimer = 0.0f;
+    }
 
-    // Disparo: usar controller si existe
-    bool firePressed = false;
-    if (ctrl) firePressed = ctrl->WantsFire();
-    else firePressed = inputManager->IsFirePressed();
-    if (firePressed) {
-            // Solo disparar si el temporizador permite
-            float effectiveCooldown = playerFireCooldown;
-            if (continueFireTimer > 0.0f) effectiveCooldown = continueFireCooldown;
-            if (playerFireTimer <= 0.0f) {
-                // Crear nueva bala en la posición del jugador
-                float bulletX = player->rect.x + player->rect.w / 2 - 2.5f; // Centrar la bala
-                float bulletY = player->rect.y - 10; // Arriba del jugador
-                // Si tenemos misiles homing, crear bala homing y consumir contador
-                bool spawnHoming = false;
-                if (homingMissilesCount > 0) {
-                    spawnHoming = true;
-                    homingMissilesCount -= 1;
-                }
+// Disparo (entrada muestreada arriba)
+bool firePressed = (input & Replay::Fire) != 0;
+if (firePressed) {
+        // Solo disparar si el temporizador permite
+        float effectiveCooldown = playerFireCooldown;
+        if (continueFireTimer > 0.0f) effectiveCooldown = continueFireCooldown;
+        if (playerFireTimer <= 0.0f) {
+            // Crear nueva bala en la posición del jugador
+            float bulletX = player->rect.x + player->rect.w / 2 - 2.5f; // Centrar la bala
+            float bulletY = player->rect.y - 10; // Arriba del jugador
+            // Si tenemos misiles homing, crear bala homing y consumir contador
+            bool spawnHoming = false;
+            if (homingMissilesCount > 0) {
+                spawnHoming = true;
+                homingMissilesCount -= 1;
+            }
 
-                if (spawnHoming) {
-                    // Intentar apuntar al enemigo más cercano y pasar target explícito.
-                    float bx = bulletX + 2.5f;
-                    float by = bulletY + 7.5f;
-                    float bestDist = 1e9f;
-                    float targetX = -1.0f;
-                    float targetY = -1.0f;
-                    for (const auto& en : enemyManager->enemies) {
-                        if (!en.alive) continue;
-                        float ex = en.rect.x + en.rect.w / 2;
-                        float ey = en.rect.y + en.rect.h / 2;
-                        float dx = ex - bx;
-                        float dy = ey - by;
-                        float dist = sqrtf(dx*dx + dy*dy);
-                        if (dist < bestDist) {
-                            bestDist = dist;
-                            targetX = ex;
-                            targetY = ey;
-                        }
-                    }
-                    // Usar velocidad vertical más lenta para misiles homing (más maniobrables)
-                    float homingVy = -220.0f; // más lento que la bala normal -300
-                    // Inicial vx 0; la lógica de Bullet calculará steering hacia target
-                    bullets.emplace_back(bulletX, bulletY, homingVy, 0.0f, true, targetX, targetY, Bullet::Owner::Player, false);
-                } else {
-                    // If ContinueFire is active, spawn smaller green bullets for continuous feel and optionally an extra one
-                    bool smaller = (continueFireTimer > 0.0f);
-                    bullets.emplace_back(bulletX, bulletY, -300.0f, 0.0f, false, -1.0f, -1.0f, Bullet::Owner::Player, smaller); // Velocidad hacia arriba
-                    if (smaller) {
-                        // spawn a second slightly offset small bullet to increase density
-                        bullets.emplace_back(bulletX + 4.0f, bulletY, -300.0f, 0.0f, false, -1.0f, -1.0f, Bullet::Owner::Player, true);
+            if (spawnHoming) {
+                // Intentar apuntar al enemigo más cercano y pasar target explícito.
+                float bx = bulletX + 2.5f;
+                float by = bulletY + 7.5f;
+                float bestDist = 1e9f;
+                float targetX = -1.0f;
+                float targetY = -1.0f;
+                const EnemyArray& foes = enemyManager->enemies;
+                for (size_t i = 0; i < foes.Size(); ++i) {
+                    if (!foes.alive[i]) continue;
+                    float ex = foes.CenterX(i);
+                    float ey = foes.CenterY(i);
+                    float dx = ex - bx;
+                    float dy = ey - by;
+                    float dist = sqrtf(dx*dx + dy*dy);
+                    if (dist < bestDist) {
+                        bestDist = dist;
+                        targetX = ex;
+                        targetY = ey;
                     }
                 }
+                // Usar velocidad vertical más lenta para misiles homing (más maniobrables)
+                float homingVy = -220.0f; // más lento que la bala normal -300
+                // Inicial vx 0; la lógica de Bullet calculará steering hacia target
+                bullets.Spawn(bulletX, bulletY, homingVy, 0.0f, true, targetX, targetY, BulletOwner::Player, false);
+            } else {
+                // If ContinueFire is active, spawn smaller green bullets for continuous feel and optionally an extra one
+                bool smaller = (continueFireTimer > 0.0f);
+                bullets.Spawn(bulletX, bulletY, -300.0f, 0.0f, false, -1.0f, -1.0f, BulletOwner::Player, smaller); // Velocidad hacia arriba
+                if (smaller) {
+                    // spawn a second slightly offset small bullet to increase density
+                    bullets.Spawn(bulletX + 4.0f, bulletY, -300.0f, 0.0f, false, -1.0f, -1.0f, BulletOwner::Player, true);
+                }
+            }
 
-                // Reproducir sonido de disparo
-                audioManager->PlaySoundManager("player_shoot", 0.7f);
+            // Reproducir sonido de disparo
+            if (audioManager) audioManager->PlaySoundManager("player_shoot", 0.7f);
 
-                // Resetear timer de disparo
-                playerFireTimer = effectiveCooldown;
-                // Telemetría: contar disparos
-                shotsFired++;
-            }
-            if (!levelTransition && !finalVictory) {
-                player->Update(realDt);
-            }
+            // Resetear timer de disparo
+            playerFireTimer = effectiveCooldown;
+            // Telemetría: contar disparos
+            shotsFired++;
         }
-
-        player->Update(realDt);
-        
-        // Actualizar balas del jugador
-        for (auto& bullet : bullets) {
-            // Las balas del jugador no se ven afectadas por bullet-time
-            bullet.Update(realDt);
-         }
-         
-         // Actualizar balas enemigas
-        for (auto& bullet : enemyBullets) {
-            // Las balas enemigas se ralentizan durante bullet-time
-            bullet.Update(scaledDt);
+        if (!levelTransition && !finalVictory) {
+            player->Update(realDt);
         }
+    }
 
-         // Actualizar powerups
-        for (auto& pu : powerUps) pu.Update(scaledDt);
-         
-         // Eliminar balas inactivas
-         bullets.erase(std::remove_if(bullets.begin(), bullets.end(), 
-             [](const Bullet& b) { return !b.active; }), bullets.end());
-         enemyBullets.erase(std::remove_if(enemyBullets.begin(), enemyBullets.end(), 
-             [](const Bullet& b) { return !b.active; }), enemyBullets.end());
-            if (!levelTransition && !finalVictory) {
-                // Los enemigos se mueven con timeScale
-                enemyManager->Update(scaledDt);
-            }
-         
-        // Disparos enemigos (se ralentizan con bullet-time)
-        enemyShootTimer += scaledDt;
-         if (enemyShootTimer >= 1.5f) { // Disparar cada 1.5 segundos
-             enemyManager->FireRandomBullet(enemyBullets);
-             enemyShootTimer = 0.0f;
-         }
-         
-         // Actualizar sistema de partículas
+    player->Update(realDt);
+    
+    {
+    PROFILE_SCOPE("bullets");
+    // Actualizar balas del jugador (no se ven afectadas por bullet-time)
+    bullets.Update(realDt);
+     
+     // Actualizar balas enemigas (se ralentizan durante bullet-time)
+    enemyBullets.Update(scaledDt);
+
+     // Actualizar powerups
+    for (auto& pu : powerUps) pu.Update(scaledDt);
+    powerUps.ReleaseIf([](const PowerUp& pu) { return !pu.active; });
+     
+     // Eliminar balas inactivas
+     bullets.RemoveInactive();
+     enemyBullets.RemoveInactive();
+    }
+        if (!levelTransition && !finalVictory) {
+            PROFILE_SCOPE("enemies");
+            // Los enemigos se mueven con timeScale
+            enemyManager->Update(scaledDt);
+        }
+     
+    // Disparos enemigos (se ralentizan con bullet-time)
+    enemyShootTimer += scaledDt;
+     if (enemyShootTimer >= 1.5f) { // Disparar cada 1.5 segundos
+         enemyManager->FireRandomBullet(enemyBullets);
+         enemyShootTimer = 0.0f;
+     }
+     
+     // Actualizar sistema de partículas
+    {
+        PROFILE_SCOPE("particles");
         particleSystem->Update(scaledDt);
-         
-         // Verificar colisiones
+    }
+     
+     // Verificar colisiones (sin renderer en headless: los edificios actualizan su textura al dibujarse)
+     SDL_Renderer* rend = nullptr;
+#ifndef SPACEINVADERS_SIM_ONLY
+     if (renderer) rend = renderer->GetSDLRenderer();
+#endif
+     {
+         PROFILE_SCOPE("collisions");
          collisionManager->CheckCollisions(*player, *enemyManager, bullets, enemyBullets, *particleSystem, *this, rend);
-            if (!levelTransition && !finalVictory) {
-                CheckForVictory();
-            }
-
-        // Actualizar timers de powerups globales con tiempo real
-        if (bulletTimeTimer > 0.0f) {
-            bulletTimeTimer -= realDt;
-            if (bulletTimeTimer < 0.0f) bulletTimeTimer = 0.0f;
+     }
+        if (!levelTransition && !finalVictory) {
+            CheckForVictory();
         }
 
-    renderer->Clear();
-    // Render background skyscrapers first so other entities (bullets, player, powerups) draw on top
+    // Actualizar timers de powerups globales con tiempo real
+    if (bulletTimeTimer > 0.0f) {
+        bulletTimeTimer -= realDt;
+        if (bulletTimeTimer < 0.0f) bulletTimeTimer = 0.0f;
+    }
+}
+
+void Game::RenderFrame(float alpha) {
+#ifndef SPACEINVADERS_SIM_ONLY
+    if (!renderer) return;
+    SDL_Renderer* rend = renderer->GetSDLRenderer();
+renderer->Clear();
+// Render background skyscrapers first so other entities (bullets, player, powerups) draw on top
+{
+    PROFILE_SCOPE("render.skyscrapers");
     enemyManager->RenderBackground(renderer->GetSDLRenderer());
-        
-        if (gameOver) {
-            // Pantalla de Game Over
-            if (textRenderer) {
-                SDL_Color red = {255, 0, 0, 255};
-                SDL_Color white = {255, 255, 255, 255};
-                textRenderer->RenderText(rend, "GAME OVER", 300, 250, red);
-                std::string finalScore = "Final Score: " + std::to_string(score);
-                textRenderer->RenderText(rend, finalScore, 280, 300, white);
-                textRenderer->RenderText(rend, "Press ESC to exit", 280, 350, white);
-            }
-        } else if (finalVictory) {
-            // Pantalla de victoria final
-            if (textRenderer) {
-                SDL_Color gold = {255, 215, 0, 255};
-                SDL_Color white = {255, 255, 255, 255};
-                textRenderer->RenderText(rend, "¡VICTORIA FINAL!", 270, 200, gold);
-                textRenderer->RenderText(rend, "Has superado todos los niveles", 200, 250, gold);
-                std::string finalScore = "Score final: " + std::to_string(score);
-                textRenderer->RenderText(rend, finalScore, 280, 300, white);
-                textRenderer->RenderText(rend, "Gracias por jugar", 290, 350, white);
-                textRenderer->RenderText(rend, "Press ESC to exit", 280, 400, white);
-            }
-        } else if (levelTransition) {
-            // Pantalla de transición de nivel
-            ShowLevelTransition();
+}
+    
+    if (gameOver) {
+        // Pantalla de Game Over
+        if (textRenderer) {
+            SDL_Color red = {255, 0, 0, 255};
+            SDL_Color white = {255, 255, 255, 255};
+            textRenderer->RenderText(rend, "GAME OVER", 300, 250, red);
+            std::string finalScore = "Final Score: " + std::to_string(score);
+            textRenderer->RenderText(rend, finalScore, 280, 300, white);
+            textRenderer->RenderText(rend, "Press ESC to exit", 280, 350, white);
+        }
+    } else if (finalVictory) {
+        // Pantalla de victoria final
+        if (textRenderer) {
+            SDL_Color gold = {255, 215, 0, 255};
+            SDL_Color white = {255, 255, 255, 255};
+            textRenderer->RenderText(rend, "¡VICTORIA FINAL!", 270, 200, gold);
+            textRenderer->RenderText(rend, "Has superado todos los niveles", 200, 250, gold);
+            std::string finalScore = "Score final: " + std::to_string(score);
+            textRenderer->RenderText(rend, finalScore, 280, 300, white);
+            textRenderer->RenderText(rend, "Gracias por jugar", 290, 350, white);
+            textRenderer->RenderText(rend, "Press ESC to exit", 280, 400, white);
+        }
+    } else if (levelTransition) {
+        // Pantalla de transición de nivel
+        ShowLevelTransition();
+    } else {
+        // Juego normal
+        // Posición interpolada del jugador entre el paso anterior y el actual
+        const SDL_FRect pr = player->RenderRect(alpha);
+        // Dibujar jugador: preferimos el sprite sheet si está disponible
+        SpriteSheet* pSheet = renderer->GetPlayerSheet();
+        const int scale = 5; // global scale x5 (8x8 -> 40x40)
+        if (pSheet && renderer->HasPlayerSheet()) {
+            // Decide player sprite index by movement direction: left=10, neutral=11, right=12
+            int idx = 11; // neutral
+            // Decide index from the last applied input (controller, keyboard or replay): left=10, neutral=11, right=12
+            if (lastInput & Replay::Left) idx = 10;
+            else if (lastInput & Replay::Right) idx = 12;
+            // Draw with tile scaling
+            SDL_Rect src = pSheet->GetSrcRect(idx);
+            SDL_FRect dst = { pr.x, pr.y, (float)(pSheet->TileW() * scale), (float)(pSheet->TileH() * scale) };
+            // Center horizontally relative to player rect width and snap dst to integer pixels
+            float cx = pr.x + (pr.w - dst.w) / 2.0f;
+            float cy = pr.y + (pr.h - dst.h) / 2.0f;
+            dst.x = (float)std::roundf(cx);
+            dst.y = (float)std::roundf(cy);
+            // Use integer source rect converted to SDL_FRect to match SDL_RenderTexture signature
+            SDL_FRect srcF = {(float)src.x, (float)src.y, (float)src.w, (float)src.h};
+            SDL_RenderTexture(rend, pSheet->GetTexture(), &srcF, &dst);
         } else {
-            // Juego normal
-            // Dibujar jugador: preferimos el sprite sheet si está disponible
-            SpriteSheet* pSheet = renderer->GetPlayerSheet();
-            const int scale = 5; // global scale x5 (8x8 -> 40x40)
-            if (pSheet && renderer->HasPlayerSheet()) {
-                // Decide player sprite index by movement direction: left=10, neutral=11, right=12
-                int idx = 11; // neutral
-                // Decide index from controller or input: left=10, neutral=11, right=12
-                IPlayerController* ctrl = player->GetController();
-                if (ctrl) {
-                    if (ctrl->WantsMoveLeft()) idx = 10;
-                    else if (ctrl->WantsMoveRight()) idx = 12;
-                } else {
-                    if (inputManager && inputManager->IsLeftPressed()) idx = 10;
-                    else if (inputManager && inputManager->IsRightPressed()) idx = 12;
-                }
-                // Draw with tile scaling
-                SDL_Rect src = pSheet->GetSrcRect(idx);
-                SDL_FRect dst = { player->rect.x, player->rect.y, (float)(pSheet->TileW() * scale), (float)(pSheet->TileH() * scale) };
-                // Center horizontally relative to player rect width and snap dst to integer pixels
-                float cx = player->rect.x + (player->rect.w - dst.w) / 2.0f;
-                float cy = player->rect.y + (player->rect.h - dst.h) / 2.0f;
-                dst.x = (float)std::roundf(cx);
-                dst.y = (float)std::roundf(cy);
-                // Use integer source rect converted to SDL_FRect to match SDL_RenderTexture signature
-                SDL_FRect srcF = {(float)src.x, (float)src.y, (float)src.w, (float)src.h};
-                SDL_RenderTexture(rend, pSheet->GetTexture(), &srcF, &dst);
+            // Fallback: existing behavior
+            SDL_Texture* pTex = renderer->GetPlayerTexture();
+            if (pTex) {
+                SDL_FRect dstF = pr;
+                SDL_RenderTexture(rend, pTex, nullptr, &dstF);
             } else {
-                // Fallback: existing behavior
-                SDL_Texture* pTex = renderer->GetPlayerTexture();
-                if (pTex) {
-                    SDL_FRect dstF = player->rect;
-                    SDL_RenderTexture(rend, pTex, nullptr, &dstF);
-                } else {
-                    // Fallback: dibujar como círculo si no hay textura
-                    SDL_Color green = {0,255,0,255};
-                    int pcx = (int)(player->rect.x + player->rect.w/2);
-                    int pcy = (int)(player->rect.y + player->rect.h/2);
-                    DrawCircle(rend, pcx, pcy, (int)(player->rect.w/2), green);
-                }
+                // Fallback: dibujar como círculo si no hay textura
+                SDL_Color green = {0,255,0,255};
+                int pcx = (int)(pr.x + pr.w/2);
+                int pcy = (int)(pr.y + pr.h/2);
+                DrawCircle(renderer, pcx, pcy, (int)(pr.w/2), green);
             }
+        }
 
-            // Dibujar escudo como círculo más grande y translúcido si activo
-            if (player->shieldActive) {
-                SDL_Color shieldColor = {0, 191, 255, static_cast<Uint8>(255 * player->shieldAlpha)}; // cyan translúcido
-                int pcx = (int)(player->rect.x + player->rect.w/2);
-                int pcy = (int)(player->rect.y + player->rect.h/2);
-                int shieldRadius = (int)(player->rect.w * 1.2f);
-                DrawCircle(rend, pcx, pcy, shieldRadius, shieldColor);
-            }
-            
-            // Dibujar balas del jugador
-            for (auto& bullet : bullets) {
-                bullet.Render(rend);
-            }
-            
-            // Dibujar balas enemigas (rojas) - saltar las inactivas para evitar residuos
-            for (auto& bullet : enemyBullets) {
-                if (!bullet.active) continue;
-                SDL_SetRenderDrawColor(rend, 255, 0, 0, 255);
-                SDL_RenderFillRect(rend, &bullet.rect);
-            }
-            
-            // Usar el método de EnemyManager para renderizar enemigos y defensas
-            // Pass the player sprite sheet (shared ships sheet) to enemy renderer so basic enemies use index 9
-            enemyManager->Render(rend, renderer->GetEnemyTexture(), renderer->GetPlayerSheet());
-
-            // Dibujar partículas
-            particleSystem->Render(rend);
-            
-            // Dibujar UI - Score (izquierda) y Lives+Level (derecha)
-            if (textRenderer) {
-                SDL_Color white = {255,255,255,255};
-                // Score arriba-izquierda
-                std::string scoreText = "Score: " + std::to_string(score);
-                textRenderer->RenderText(rend, scoreText, 16, 12, white);
-
-                // Preparar sprite sheet misc (lazy-load) para icono de vida
-                static SpriteSheet miscSheet;
-                static bool miscLoaded = false;
-                if (!miscLoaded) {
-                    std::string path = "assets/sprites/SpaceShooterAssetPack_Miscellaneous.png";
-                    miscLoaded = miscSheet.Load(rend, path, 8, 8);
-                }
+        // Dibujar escudo como círculo más grande y translúcido si activo
+        if (player->shieldActive) {
+            SDL_Color shieldColor = {0, 191, 255, static_cast<Uint8>(255 * player->shieldAlpha)}; // cyan translúcido
+            int pcx = (int)(pr.x + pr.w/2);
+            int pcy = (int)(pr.y + pr.h/2);
+            int shieldRadius = (int)(pr.w * 1.2f);
+            DrawCircle(renderer, pcx, pcy, shieldRadius, shieldColor);
+        }
+        
+        // Entidades por lotes: cada Flush es una SDL_RenderGeometry por textura. Se vacía
+        // entre capas para que balas < enemigos < partículas sigan en ese orden.
+        SpriteBatch& batch = renderer->GetBatch();
 
-                // Lives: dibujar icono de vida (map index 2) en esquina superior derecha seguido de "xN"
-                const float padding = 12.0f;
-                const float iconSize = 24.0f; // 8x8 tile scaled to 24 px (3x)
-                const float screenW = 800.0f; // same assumption as rest of code
-
-                // Build lives text and estimate widths to center the block (icon + small gap + text)
-                std::string livesText = "x" + std::to_string(lives);
-                const float charW = 10.0f; // approximate char width in pixels for centering
-                float livesTextW = charW * (float)livesText.size();
-                const float gap = 6.0f; // gap between icon and text
-                float blockW = iconSize + gap + livesTextW;
-
-                float blockX = (screenW - blockW) / 2.0f;
-                float iconX = blockX;
-                float iconY = 12.0f;
-
-                if (miscLoaded && miscSheet.GetTexture()) {
-                    SDL_Rect src = miscSheet.GetSrcRect(2); // ExtraLife icon index as life icon
-                    SDL_FRect srcF = {(float)src.x, (float)src.y, (float)src.w, (float)src.h};
-                    SDL_FRect dstF = { iconX, iconY, iconSize, iconSize };
-                    SDL_RenderTexture(rend, miscSheet.GetTexture(), &srcF, &dstF);
-                } else {
-                    // fallback: draw a green heart-like square
-                    SDL_SetRenderDrawColor(rend, 0, 200, 0, 255);
-                    SDL_FRect heart = { iconX, iconY, iconSize, iconSize };
-                    SDL_RenderFillRect(rend, &heart);
-                }
+        // Dibujar balas del jugador y enemigas (rojas): un solo lote de color sólido
+        {
+            PROFILE_SCOPE("render.bullets");
+            bullets.Render(batch, alpha);
+            enemyBullets.Render(batch, alpha);
+            batch.Flush(rend);
+        }
+        
+        // Usar el método de EnemyManager para renderizar enemigos y defensas
+        // Pass the player sprite sheet (shared ships sheet) to enemy renderer so basic enemies use index 9
+        {
+            PROFILE_SCOPE("render.enemies");
+            enemyManager->Render(batch, renderer->GetEnemyTexture(), renderer->GetPlayerSheet(), alpha);
+            batch.Flush(rend);
+        }
+
+        // Dibujar partículas
+        {
+            PROFILE_SCOPE("render.particles");
+            particleSystem->Render(batch);
+            batch.Flush(rend);
+        }
+        
+        // Dibujar UI - Score (izquierda) y Lives+Level (derecha)
+        if (textRenderer) {
+            PROFILE_SCOPE("render.hud");
+            SDL_Color white = {255,255,255,255};
+            // Score arriba-izquierda
+            std::string scoreText = "Score: " + std::to_string(score);
+            textRenderer->RenderText(rend, scoreText, 16, 12, white);
+
+            // Sprite sheet misc (cargado por Renderer) para icono de vida
+            SpriteSheet* miscSheet = renderer->GetMiscSheet();
+
+            // Lives: dibujar icono de vida (map index 2) en esquina superior derecha seguido de "xN"
+            const float padding = 12.0f;
+            const float iconSize = 24.0f; // 8x8 tile scaled to 24 px (3x)
+            const float screenW = 800.0f; // same assumption as rest of code
+
+            // Build lives text and estimate widths to center the block (icon + small gap + text)
+            std::string livesText = "x" + std::to_string(lives);
+            const float charW = 10.0f; // approximate char width in pixels for centering
+            float livesTextW = charW * (float)livesText.size();
+            const float gap = 6.0f; // gap between icon and text
+            float blockW = iconSize + gap + livesTextW;
 
-                // Draw lives text to the right of the icon
-                float textX = iconX + iconSize + gap;
-                float textY = iconY + (iconSize - 12.0f) / 2.0f; // center vertically (text assumed ~12px high)
-                textRenderer->RenderText(rend, livesText, (int)textX, (int)textY, white);
-
-                // Level: place in top-right corner (so it doesn't overlap centered lives block)
-                int displayMaxLevels = 125;
-                std::string levelText = "Level " + std::to_string(currentLevel + 1) + "/" + std::to_string(displayMaxLevels);
-                float levelTextW = charW * (float)levelText.size();
-                // use same horizontal margin as Score (approx 16 px) so level text isn't flush to the edge
-                float levelX = screenW - 32.0f - levelTextW;
-                float levelY = 12.0f;
-                textRenderer->RenderText(rend, levelText, (int)levelX, (int)levelY, white);
+            float blockX = (screenW - blockW) / 2.0f;
+            float iconX = blockX;
+            float iconY = 12.0f;
+
+            if (miscSheet && miscSheet->GetTexture()) {
+                SDL_Rect src = miscSheet->GetSrcRect(2); // ExtraLife icon index as life icon
+                SDL_FRect srcF = {(float)src.x, (float)src.y, (float)src.w, (float)src.h};
+                SDL_FRect dstF = { iconX, iconY, iconSize, iconSize };
+                SDL_RenderTexture(rend, miscSheet->GetTexture(), &srcF, &dstF);
+            } else {
+                // fallback: draw a green heart-like square
+                SDL_SetRenderDrawColor(rend, 0, 200, 0, 255);
+                SDL_FRect heart = { iconX, iconY, iconSize, iconSize };
+                SDL_RenderFillRect(rend, &heart);
             }
 
-            // Dibujar powerups
-            for (auto& pu : powerUps) pu.Render(rend);
+            // Draw lives text to the right of the icon
+            float textX = iconX + iconSize + gap;
+            float textY = iconY + (iconSize - 12.0f) / 2.0f; // center vertically (text assumed ~12px high)
+            textRenderer->RenderText(rend, livesText, (int)textX, (int)textY, white);
+
+            // Level: place in top-right corner (so it doesn't overlap centered lives block)
+            int displayMaxLevels = 125;
+            std::string levelText = "Level " + std::to_string(currentLevel + 1) + "/" + std::to_string(displayMaxLevels);
+            float levelTextW = charW * (float)levelText.size();
+            // use same horizontal margin as Score (approx 16 px) so level text isn't flush to the edge
+            float levelX = screenW - 32.0f - levelTextW;
+            float levelY = 12.0f;
+            textRenderer->RenderText(rend, levelText, (int)levelX, (int)levelY, white);
         }
-        renderer->Present();
-        SDL_Delay(16);
+
+        // Dibujar powerups
+        for (auto& pu : powerUps) pu.Render(batch, renderer->GetMiscSheet(), alpha);
+        batch.Flush(rend);
     }
+#else
+    (void)alpha;
+#endif
 }
 
+
 void Game::Shutdown() {
-    delete player;
-    delete enemyManager;
-    delete renderer;
-    delete inputManager;
-    delete collisionManager;
-    delete particleSystem;
-    delete textRenderer;
-    delete audioManager;
-    SDL_Quit();
+    delete player; player = nullptr;
+    delete enemyManager; enemyManager = nullptr;
+    delete inputManager; inputManager = nullptr;
+    delete collisionManager; collisionManager = nullptr;
+    delete particleSystem; particleSystem = nullptr;
+    delete replayRecord; replayRecord = nullptr;
+    delete replayPlayback; replayPlayback = nullptr;
+#ifndef SPACEINVADERS_SIM_ONLY
+    // El atlas de texto es una textura del renderer: antes que él
+    delete textRenderer; textRenderer = nullptr;
+    delete renderer; renderer = nullptr;
+    delete audioManager; audioManager = nullptr;
+    // Sólo el modo con ventana inicializa SDL; en headless puede haber otras partidas
+    // corriendo en el mismo proceso y no hay que tocar el estado global de SDL
+    if (!headlessEnabled) {
+        AssetCache::Get().Clear();
+        SDL_Quit();
+    }
+#endif
 }
 
 void Game::AddScore(int points) {
@@ -523,7 +702,7 @@ void Game::LoseLife() {
     if (lives <= 0) {
         gameOver = true;
         // Registrar en historial
-        elapsedTime = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count() - startTime;
+        elapsedTime = simTime;
         SaveGameHistoryEntry();
     }
 }
@@ -541,39 +720,207 @@ void Game::CheckForVictory() {
         return; // Si ya el juego terminó o está en transición, no verificar
     }
     // Contar enemigos vivos
-    int aliveEnemies = 0;
-    for (const auto& enemy : enemyManager->enemies) {
-        if (enemy.alive) {
-            aliveEnemies++;
-        }
-    }
+    int aliveEnemies = enemyManager->enemies.AliveCount();
     // Si no hay enemigos vivos, activar transición o victoria final
     if (aliveEnemies == 0) {
         if (currentLevel >= 24) { // 0-indexed, nivel 25
             finalVictory = true;
             // Registrar victoria en historial
-            elapsedTime = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count() - startTime;
+            elapsedTime = simTime;
             SaveGameHistoryEntry();
-            std::cout << "¡VICTORIA FINAL! Has superado todos los niveles. Score final: " << score << std::endl;
+            LOG_INFO(Game, "¡VICTORIA FINAL! Has superado todos los niveles. Score final: " << score);
         } else {
             levelTransition = true;
             // Registrar el fin de este nivel en el historial para tuning (escribe logs/run_<seed>.json)
-            elapsedTime = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count() - startTime;
+            elapsedTime = simTime;
             SaveGameHistoryEntry();
-            std::cout << "Nivel superado: " << (currentLevel+1) << ". Pulsa una tecla para continuar." << std::endl;
+            LOG_INFO(Game, "Nivel superado: " << (currentLevel+1) << ". Pulsa una tecla para continuar.");
         }
         gameWon = false;
         gameOver = false;
     }
 }
 
+void Game::FinishTrace() {
+    if (config.tracePath.empty()) return;
+    Profiler::Get().Disable();
+    Profiler::Get().WriteChromeTrace(config.tracePath);
+}
+
+void Game::StepCounted(float dt) {
+    if (!config.allocStats) {
+        Step(dt);
+        return;
+    }
+    const uint64_t before = AllocCounter::Allocations();
+    Step(dt);
+    allocStats.Record(AllocCounter::Allocations() - before);
+}
+
+void Game::FinishAllocStats() {
+    if (!config.allocStats) return;
+    const AllocStats& a = allocStats;
+    LOG_INFO(Game, "Alloc stats: " << a.steps << " steps, " << a.allocations << " allocations (max "
+             << a.maxInStep << " in one step); steady state (after " << AllocStats::WarmupSteps
+             << " steps per level): " << a.steadyAllocations << " allocations in "
+             << a.steadyStepsWithAllocs << " of " << a.steadySteps << " steps");
+}
+
+void Game::FinishPoolStats() {
+    // Un solo aviso por partida: con los pools llenos se pierden disparos o drops
+    const uint64_t shots = bullets.Rejected() + enemyBullets.Rejected();
+    const uint64_t drops = powerUps.Rejected();
+    if (shots == 0 && drops == 0) return;
+    LOG_WARN(Game, "Pools llenos: " << shots << " disparos (capacidad " << bullets.Capacity() << ") y "
+             << drops << " powerups (capacidad " << powerUps.Capacity() << ") perdidos");
+}
+
+void Game::FinishReplay() {
+    if (!replayRecord) return;
+    replayRecord->finalScore = score;
+    replayRecord->finalSimTime = simTime;
+    std::filesystem::path path(config.recordPath);
+    std::error_code ec;
+    if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path(), ec);
+    if (replayRecord->Save(config.recordPath)) {
+        LOG_INFO(Replay, "Recorded " << replayRecord->TickCount() << " ticks (" << replayRecord->RunCount()
+                 << " runs) to " << config.recordPath);
+    }
+}
+
+void Game::VerifyReplay() {
+    // Misma semilla + misma entrada => mismo resultado; si no, algo no determinista ha cambiado
+    bool match = (score == replayPlayback->finalScore && simTime == replayPlayback->finalSimTime);
+    if (match) {
+        LOG_INFO(Replay, "Finished: score " << score << ", sim time " << simTime << "s -> matches recording");
+    } else {
+        LOG_ERROR(Replay, "Finished: score " << score << ", sim time " << simTime << "s -> MISMATCH with recording (recorded score "
+                  << replayPlayback->finalScore << ", " << replayPlayback->finalSimTime << "s)");
+    }
+}
+
+// Cabecera del snapshot: cambia la versión si cambia el formato
+static const uint32_t kStateMagic = 0x53475349; // "ISGS"
+static const uint32_t kStateVersion = 4; // 2: enemigos y balas en arrays SoA; 3: pools de balas y powerups; 4: history de edificios por deltas
+
+GameState Game::SaveState() const {
+    GameState st;
+    SaveState(st);
+    return st;
+}
+
+void Game::SaveState(GameState& out) const {
+    out.bytes.clear();
+    StateWriter w(out.bytes);
+    w.Put(kStateMagic);
+    w.Put(kStateVersion);
+
+    // Estado de partida y powerups
+    w.Put(score); w.Put(lives); w.Put(gameOver); w.Put(gameWon); w.Put(enemyShootTimer);
+    w.Put(currentLevel); w.Put(levelTransition); w.Put(finalVictory);
+    w.Put(simTime); w.Put(elapsedTime); w.Put(timedOut);
+    w.Put(bulletTimeTimer); w.Put(homingMissilesCount);
+    w.Put(shieldActive); w.Put(shieldTimer); w.Put(shieldHp);
+    w.Put(playerFireCooldown); w.Put(playerFireTimer);
+    w.Put(continueFireCooldown); w.Put(continueFireTimer);
+    w.Put(powerupTestMode); w.Put(powerupTestIndex); w.Put(killsSinceLevelStart);
+    // Telemetría
+    w.Put(powerupsCollected); w.Put(enemyHitsTaken); w.Put(shotsFired); w.Put(timeIdle);
+    w.Put(lastPlayerX); w.Put(lastMoveTimestamp);
+    w.Put(powerupPickupLatencySum); w.Put(powerupPickupCount);
+    // RNG
+    w.Put(rng);
+
+    player->SaveState(w);
+    enemyManager->SaveState(w);
+    bullets.SaveState(w);
+    enemyBullets.SaveState(w);
+    powerUps.SaveState(w);
+    particleSystem->SaveState(w);
+
+    // Controlador: bloque con longitud prefijada (su formato depende del tipo de controlador)
+    size_t lenAt = w.Position();
+    w.Put<uint32_t>(0);
+    IPlayerController* ctrl = player->GetController();
+    if (ctrl) ctrl->SaveState(w);
+    uint32_t ctrlLen = (uint32_t)(w.Position() - lenAt - sizeof(uint32_t));
+    memcpy(out.bytes.data() + lenAt, &ctrlLen, sizeof(ctrlLen));
+}
+
+bool Game::RestoreState(const GameState& state) {
+    if (!player || !enemyManager || !particleSystem) return false;
+    StateReader r(state.bytes.data(), state.bytes.size());
+    uint32_t magic = 0, version = 0;
+    if (!r.Get(magic) || !r.Get(version) || magic != kStateMagic || version != kStateVersion) {
+        LOG_ERROR(Game, "RestoreState: snapshot invalido o de otra version");
+        return false;
+    }
+
+    r.Get(score); r.Get(lives); r.Get(gameOver); r.Get(gameWon); r.Get(enemyShootTimer);
+    r.Get(currentLevel); r.Get(levelTransition); r.Get(finalVictory);
+    r.Get(simTime); r.Get(elapsedTime); r.Get(timedOut);
+    r.Get(bulletTimeTimer); r.Get(homingMissilesCount);
+    r.Get(shieldActive); r.Get(shieldTimer); r.Get(shieldHp);
+    r.Get(playerFireCooldown); r.Get(playerFireTimer);
+    r.Get(continueFireCooldown); r.Get(continueFireTimer);
+    r.Get(powerupTestMode); r.Get(powerupTestIndex); r.Get(killsSinceLevelStart);
+    r.Get(powerupsCollected); r.Get(enemyHitsTaken); r.Get(shotsFired); r.Get(timeIdle);
+    r.Get(lastPlayerX); r.Get(lastMoveTimestamp);
+    r.Get(powerupPickupLatencySum); r.Get(powerupPickupCount);
+    r.Get(rng);
+
+    bool ok = player->RestoreState(r) && enemyManager->RestoreState(r) &&
+              bullets.RestoreState(r) && enemyBullets.RestoreState(r);
+    ok = ok && powerUps.RestoreState(r) && particleSystem->RestoreState(r);
+
+    uint32_t ctrlLen = 0;
+    if (ok && r.Get(ctrlLen)) {
+        StateReader cr = r.Sub(ctrlLen);
+        IPlayerController* ctrl = player->GetController();
+        if (ctrl && ctrlLen > 0) ok = ctrl->RestoreState(cr);
+    }
+    ok = ok && r.Ok() && r.AtEnd();
+    if (!ok) {
+        LOG_ERROR(Game, "RestoreState: snapshot truncado o corrupto");
+        return false;
+    }
+    // Una partida restaurada sigue en marcha aunque la original ya hubiera terminado el bucle
+    running = !(headlessEnabled && (gameOver || levelTransition || finalVictory));
+    return true;
+}
+
+RunMetrics Game::GetRunMetrics() const {
+    RunMetrics m;
+    m.seed = runSeed;
+    m.durationSeconds = elapsedTime;
+    m.maxLevel = currentLevel + 1; // humano-friendly
+    m.lives = lives;
+    m.score = score;
+    m.powerupsCollected = powerupsCollected;
+    m.enemyHitsTaken = enemyHitsTaken;
+    m.shotsFired = shotsFired;
+    m.timeIdle = timeIdle;
+    m.powerupPickupCount = powerupPickupCount;
+    m.powerupPickupLatencyAvg = powerupPickupCount > 0 ? powerupPickupLatencySum / (double)powerupPickupCount : 0.0;
+    m.timedOut = timedOut;
+    return m;
+}
+
 void Game::SaveGameHistoryEntry() {
+    // Con varias partidas en el mismo proceso (SimulationRunner) no se escriben ficheros:
+    // las métricas se recogen con GetRunMetrics()
+    if (!config.writeHistory) {
+        // En replay headless el final lo marca la cinta (puede incluir varios niveles)
+        if (headlessEnabled && !replayPlayback) running = false;
+        return;
+    }
+    const RunMetrics m = GetRunMetrics();
     try {
         json entry;
-        entry["duration_seconds"] = elapsedTime;
-        entry["max_level"] = currentLevel + 1; // humano-friendly
-        entry["lives"] = lives;
-        entry["score"] = score;
+        entry["duration_seconds"] = m.durationSeconds;
+        entry["max_level"] = m.maxLevel;
+        entry["lives"] = m.lives;
+        entry["score"] = m.score;
 
         // Leer archivo existente
         std::string path = "Data/games_history.json";
@@ -593,36 +940,35 @@ void Game::SaveGameHistoryEntry() {
         out << root.dump(2);
         out.close();
 
-        std::cout << "[Game] Game history entry saved." << std::endl;
+        LOG_INFO(Game, "Game history entry saved.");
         // Also write a per-run JSON for external tuning scripts, ensure logs directory exists
         try {
             json runj;
-            runj["seed"] = runSeed;
-            runj["duration_seconds"] = elapsedTime;
-            runj["max_level"] = currentLevel + 1;
-            runj["lives"] = lives;
-            runj["score"] = score;
+            runj["seed"] = m.seed;
+            runj["duration_seconds"] = m.durationSeconds;
+            runj["max_level"] = m.maxLevel;
+            runj["lives"] = m.lives;
+            runj["score"] = m.score;
             std::filesystem::path logsdir("logs");
             std::error_code ec;
             std::filesystem::create_directories(logsdir, ec);
             if (!ec) {
                 // Add telemetry fields
-                runj["powerups_collected"] = powerupsCollected;
-                runj["enemy_hits_taken"] = enemyHitsTaken;
-                runj["shots_fired"] = shotsFired;
-                runj["time_idle"] = timeIdle;
+                runj["powerups_collected"] = m.powerupsCollected;
+                runj["enemy_hits_taken"] = m.enemyHitsTaken;
+                runj["shots_fired"] = m.shotsFired;
+                runj["time_idle"] = m.timeIdle;
                 // Powerup pickup latency (average)
-                runj["powerup_pickup_count"] = powerupPickupCount;
-                if (powerupPickupCount > 0) runj["powerup_pickup_latency_avg"] = powerupPickupLatencySum / (double)powerupPickupCount;
-                else runj["powerup_pickup_latency_avg"] = 0.0;
+                runj["powerup_pickup_count"] = m.powerupPickupCount;
+                runj["powerup_pickup_latency_avg"] = m.powerupPickupLatencyAvg;
 
                 std::filesystem::path runpath = logsdir / (std::string("run_") + std::to_string(runSeed) + std::string(".json"));
                 std::ofstream r(runpath.string());
                 if (r.good()) { r << runj.dump(2); r.close(); }
                 // If running fully headless (automation), stop the main loop so the process exits cleanly
                 // Do NOT auto-exit for interactive autoplay so the game can continue running in a window.
-                if (headlessEnabled) {
-                    std::cout << "[Game] Headless mode: exiting after logging for seed " << runSeed << std::endl;
+                if (headlessEnabled && !replayPlayback) {
+                    LOG_INFO(Game, "Headless mode: exiting after logging for seed " << runSeed);
                     running = false;
                 }
             }
@@ -630,7 +976,7 @@ void Game::SaveGameHistoryEntry() {
             // ignore logging errors
         }
     } catch (const std::exception& e) {
-        std::cerr << "[Game] Failed to save game history: " << e.what() << std::endl;
+        LOG_ERROR(Game, "Failed to save game history: " << e.what());
     }
 }
 
@@ -657,17 +1003,19 @@ void Game::NextLevel() {
     levelTransition = false;
 
     // Limpiar power-ups al cambiar de nivel para que no persistan
-    powerUps.clear();
+    powerUps.Clear();
     
     // Cargar el siguiente nivel
     enemyManager->LoadLevel(currentLevel);
+    allocStats.NewLevel();
      // Resetear balas y estados
-     bullets.clear();
-     enemyBullets.clear();
+     bullets.Clear();
+     enemyBullets.Clear();
      gameWon = false;
      gameOver = false;
      player->rect.x = 350; // Centrar jugador
      player->rect.y = 550;
+     player->SavePrevRect();
     // Reset kill counter for the new level
     killsSinceLevelStart = 0;
 }
@@ -678,7 +1026,7 @@ bool Game::OnEnemyKilled(float spawnX, float spawnY) {
     if (currentLevel == 0 && killsSinceLevelStart >= 3) {
         killsSinceLevelStart = 0;
         // Elegir tipo aleatorio (ahora 6 tipos incluyendo ContinueFire)
-        int r = rand() % 6;
+        int r = rng.drops.Range(6);
         PowerUp::Type chosen = PowerUp::Type::RestoreDefense;
         switch (r) {
             case 0: chosen = PowerUp::Type::RestoreDefense; break;
@@ -697,13 +1045,14 @@ bool Game::OnEnemyKilled(float spawnX, float spawnY) {
         // Spawn en la posición del enemigo si se proporciona
         PowerUp pu(px, py, chosen);
         SpawnPowerUp(pu);
-        std::cout << "[Game] Level1 rule: spawned forced powerup (" << (int)chosen << ") after 3 kills" << std::endl;
+        LOG_INFO(Game, "Level1 rule: spawned forced powerup (" << (int)chosen << ") after 3 kills");
         return true;
     }
     return false;
 }
 
 void Game::ShowLevelTransition() {
+#ifndef SPACEINVADERS_SIM_ONLY
     if (textRenderer) {
         SDL_Color yellow = {255, 255, 0, 255};
         SDL_Color white = {255, 255, 255, 255};
@@ -711,33 +1060,35 @@ void Game::ShowLevelTransition() {
         textRenderer->RenderText(renderer->GetSDLRenderer(), msg, 250, 250, yellow);
         textRenderer->RenderText(renderer->GetSDLRenderer(), "Pulsa cualquier tecla para continuar", 180, 300, white);
     }
+#endif
 }
 
 void Game::SpawnPowerUp(const PowerUp& pu) {
-    // copy and set absolute spawn time
-    PowerUp copy = pu;
-    copy.spawnAbsTime = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
-    powerUps.push_back(copy);
+    // copy and set spawn time (simulated seconds)
+    PowerUp* slot = powerUps.Acquire();
+    if (!slot) return; // pool lleno: se cuenta y se resume al terminar (FinishPoolStats)
+    *slot = pu;
+    slot->spawnTime = simTime;
 }
 
-std::vector<PowerUp>& Game::GetPowerUps() {
+PowerUpPool& Game::GetPowerUps() {
     return powerUps;
 }
 
 // API de powerups
 void Game::ActivateBulletTime(float seconds) {
     bulletTimeTimer = std::max(bulletTimeTimer, seconds);
-    std::cout << "[Game] BulletTime activated: " << bulletTimeTimer << "s" << std::endl;
+    LOG_INFO(Game, "BulletTime activated: " << bulletTimeTimer << "s");
 }
 
 void Game::AddLives(int n) {
     lives += n;
-    std::cout << "[Game] Lives increased: " << lives << std::endl;
+    LOG_INFO(Game, "Lives increased: " << lives);
 }
 
 void Game::AddHomingMissiles(int n) {
     homingMissilesCount += n;
-    std::cout << "[Game] Homing missiles now: " << homingMissilesCount << std::endl;
+    LOG_INFO(Game, "Homing missiles now: " << homingMissilesCount);
 }
 
 void Game::ActivateShield(int hp, float duration) {
@@ -751,12 +1102,12 @@ void Game::ActivateShield(int hp, float duration) {
         player->shieldTimer = duration;
         player->shieldAlpha = 0.15f;
     }
-    std::cout << "[Game] Shield activated: hp=" << hp << " duration=" << duration << std::endl;
+    LOG_INFO(Game, "Shield activated: hp=" << hp << " duration=" << duration);
 }
 
 void Game::SetPowerupTestMode(bool enable) {
     powerupTestMode = enable;
-    std::cout << "[Game] Powerup test mode " << (enable ? "ENABLED" : "DISABLED") << std::endl;
+    LOG_INFO(Game, "Powerup test mode " << (enable ? "ENABLED" : "DISABLED"));
 }
 
 bool Game::IsPowerupTestMode() const {
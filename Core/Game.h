@@ -2,23 +2,48 @@
 #include "Player.h"
 #include "EnemyManager.h"
 #include "Bullet.h"
-#include "Renderer.h"
 #include "InputManager.h"
 #include "CollisionManager.h"
 #include "ParticleSystem.h"
-#include "TextRenderer.h"
-#include "AudioManagerBeep.h"
-#include "AudioManagerMiniaudio.h"
 #include "PowerUp.h"
+#include "Rng.h"
+#include "GameConfig.h"
+#include "GameState.h"
+#include "AllocCounter.h"
 #include <vector>
 
+// Subsistemas de presentación: sólo existen en el build con ventana.
+// En modo headless (y en el build SPACEINVADERS_SIM_ONLY) quedan a nullptr.
+class Renderer;
+class TextRenderer;
+class AudioManagerMiniaudio;
+class Replay;
+
 class Game {
 public:
     Game();
     ~Game();
-    bool Init();
+    bool Init(const GameConfig& cfg);
     void Run();
     void Shutdown();
+
+    // Un paso de simulación (jugador, enemigos, balas, colisiones, powerups, telemetría).
+    // No toca SDL video ni audio; es lo único que se ejecuta en modo headless.
+    void Step(float realDt);
+    // Dibuja el estado actual (sólo con ventana). alpha en [0,1] interpola las posiciones
+    // entre el paso anterior y el actual según el tiempo sobrante del acumulador.
+    void RenderFrame(float alpha = 1.0f);
+
+    // Paso fijo de simulación: 0.016s, el mismo dt con el que se ajustó toda la jugabilidad
+    static constexpr float FixedStep = 0.016f;
+    // Máximo de pasos por frame para recuperar retraso (evita la espiral en máquinas lentas)
+    static constexpr int MaxCatchUpSteps = 5;
+    bool IsRunning() const { return running; }
+    bool IsHeadless() const { return headlessEnabled; }
+    // Tiempo simulado acumulado (segundos); base de duration_seconds y latencias
+    double GetSimTime() const { return simTime; }
+    // Streams de RNG de esta partida (sembrados con --seed)
+    GameRng& GetRng() { return rng; }
     
     // Sistema de puntuación
     void AddScore(int points);
@@ -35,7 +60,7 @@ public:
 
     // PowerUp API
     void SpawnPowerUp(const PowerUp& pu);
-    std::vector<PowerUp>& GetPowerUps();
+    PowerUpPool& GetPowerUps();
 
     // API pública para efectos de powerups
     void ActivateBulletTime(float seconds);
@@ -44,8 +69,20 @@ public:
     void AddHomingMissiles(int n);
     void ActivateShield(int hp, float duration);
 
+    // Snapshot completo de la simulación (jugador, enemigos, edificios, balas, powerups,
+    // timers, nivel, RNG y decisiones pendientes del controlador) en un blob contiguo.
+    // Sirve para clonar/ramificar partidas (IA con lookahead), checkpoints y rollback.
+    // La partida destino debe estar inicializada (Init); la configuración no se toca.
+    GameState SaveState() const;
+    void SaveState(GameState& out) const; // reutiliza el buffer de out
+    bool RestoreState(const GameState& state);
+
     // Historial de partidas
     void SaveGameHistoryEntry();
+    // Métricas de la partida (lo mismo que se escribe en logs/run_<seed>.json)
+    RunMetrics GetRunMetrics() const;
+    // Índice para ciclar tipos de powerup en modo test (antes un static en CollisionManager)
+    int NextPowerupTestIndex() { return powerupTestIndex++; }
 
     // Telemetry getters (read-only)
     int GetPowerupsCollected() const { return powerupsCollected; }
@@ -77,9 +114,10 @@ private:
     ParticleSystem* particleSystem;
     TextRenderer* textRenderer;
     AudioManagerMiniaudio* audioManager;
-    std::vector<Bullet> bullets;
-    std::vector<Bullet> enemyBullets;
-    std::vector<PowerUp> powerUps;
+    BulletArray bullets;
+    BulletArray enemyBullets;
+    PowerUpPool powerUps{32}; // GameConfig::powerUpCapacity (Init)
+    WorldObservation observation; // la que Step pasa al controlador (buffers reutilizados)
     // Estados globales de powerups
     float bulletTimeTimer = 0.0f; // tiempo restante de bullet-time
     int homingMissilesCount = 0;  // cuántos misiles homing restantes
@@ -108,10 +146,28 @@ private:
         void NextLevel();
         void ShowLevelTransition();
 
-        // Tiempos de partida
-        double startTime = 0.0;
+        // Tiempos de partida (en segundos simulados, no de reloj de pared)
+        double simTime = 0.0;
         double elapsedTime = 0.0;
         int runSeed = 0;
+        GameRng rng;
+        GameConfig config;
+        // Grabación/reproducción de entrada (--record / --replay)
+        Replay* replayRecord = nullptr;
+        Replay* replayPlayback = nullptr;
+        bool replayFinished = false;
+        bool pendingAdvance = false; // NextLevel pedido por tecla, se graba en el siguiente tick
+        uint8_t lastInput = 0;       // bits Replay::Left/Right/Fire del último tick (sprite del jugador)
+        void FinishReplay();         // guarda la grabación al terminar Run
+        void VerifyReplay();         // compara el resultado con el de la grabación
+        void FinishTrace();          // escribe el trace de --trace al terminar Run
+        // --alloc-stats: reservas de memoria por paso
+        AllocStats allocStats;
+        void StepCounted(float dt);  // Step midiendo las reservas si --alloc-stats
+        void FinishAllocStats();     // resumen al terminar Run
+        void FinishPoolStats();      // aviso único si algún pool llenó (disparos/powerups perdidos)
+        // true si la partida terminó por GameConfig::maxSimSeconds
+        bool timedOut = false;
     // Execution mode flags
     bool autoplayEnabled = false;
     bool headlessEnabled = false;
@@ -128,6 +184,7 @@ private:
     int powerupPickupCount = 0;
     // Test mode: si true, todos los enemigos sueltan powerups para testing
     bool powerupTestMode = false;
+    int powerupTestIndex = 0;
     // Conteo de muertes desde el inicio del nivel (para reglas como Level 1 -> drop tras 3 kills)
     int killsSinceLevelStart = 0;
 };
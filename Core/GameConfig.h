@@ -0,0 +1,103 @@
+#pragma once
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+
+// Parámetros ajustables de la IA de pruebas (tools/ai). Por defecto coinciden con las
+// constantes originales; el script de Optuna los pasa como variables de entorno.
+struct AIParams {
+    float enemyW = 44.0f;
+    float enemyH = 30.0f;
+    float occlusionPenalty = 10.0f;
+
+    // Lee AI_ENEMY_W / AI_ENEMY_H / AI_OCCLUSION_PENALTY si existen
+    static AIParams FromEnv() {
+        AIParams p;
+        const char* ew = std::getenv("AI_ENEMY_W");
+        const char* eh = std::getenv("AI_ENEMY_H");
+        const char* op = std::getenv("AI_OCCLUSION_PENALTY");
+        if (ew) p.enemyW = static_cast<float>(std::atof(ew));
+        if (eh) p.enemyH = static_cast<float>(std::atof(eh));
+        if (op) p.occlusionPenalty = static_cast<float>(std::atof(op));
+        return p;
+    }
+};
+
+// Configuración de una partida. Todo lo que antes se leía de globales (__argc/__argv,
+// variables de entorno) entra por aquí, de modo que varias instancias de Game pueden
+// convivir en el mismo proceso con semillas y parámetros distintos.
+struct GameConfig {
+    bool autoplay = false;
+    bool headless = false;
+    unsigned int seed = 0;
+    AIParams ai;
+    // Escribir Data/games_history.json y logs/run_<seed>.json al terminar.
+    // SimulationRunner lo desactiva: varias partidas a la vez se pisarían los ficheros.
+    bool writeHistory = true;
+    // Límite de tiempo simulado (segundos) para runs headless; 0 = sin límite
+    double maxSimSeconds = 0.0;
+    // --record [fichero]: grabar la entrada de cada tick (por defecto logs/run_<seed>.replay)
+    std::string recordPath;
+    // --replay fichero: reproducir una grabación (la semilla sale del fichero; sin IA)
+    std::string replayPath;
+    // --replay-speed X: velocidad de reproducción con ventana (en headless va lo más rápido posible)
+    float replaySpeed = 1.0f;
+    // --trace fichero.json: activar el profiler por fases y volcar un trace de chrome://tracing
+    std::string tracePath;
+    // --alloc-stats: contar reservas de memoria por paso y resumirlas al terminar
+    bool allocStats = false;
+    // Huecos del pool de powerups. En partida sobran (pocos drops a la vez); el bench lo sube
+    // para escenas de miles de enemigos en las que un solo paso puede soltar cientos
+    uint32_t powerUpCapacity = 32;
+
+    // Parsea la línea de comandos del ejecutable (--autoplay, --headless, --seed N,
+    // --record [fichero], --replay fichero, --replay-speed X, --trace fichero.json, --alloc-stats)
+    static GameConfig FromArgs(int argc, char* argv[]) {
+        GameConfig cfg;
+        bool seedGiven = false;
+        for (int i = 1; i < argc; ++i) {
+            if (argv[i] == nullptr) continue;
+            std::string s(argv[i]);
+            if (s == "--autoplay") cfg.autoplay = true;
+            if (s == "--headless") cfg.headless = true;
+            if (s == "--seed" && i + 1 < argc) {
+                cfg.seed = static_cast<unsigned int>(std::stoul(argv[i + 1]));
+                seedGiven = true;
+            }
+            if (s == "--record") {
+                // Ruta opcional; sin ella se usa logs/run_<seed>.replay (se resuelve al final)
+                bool hasPath = (i + 1 < argc && argv[i + 1] != nullptr && std::string(argv[i + 1]).rfind("--", 0) != 0);
+                cfg.recordPath = hasPath ? argv[++i] : "*";
+            }
+            if (s == "--replay" && i + 1 < argc) cfg.replayPath = argv[++i];
+            if (s == "--replay-speed" && i + 1 < argc) cfg.replaySpeed = static_cast<float>(std::atof(argv[++i]));
+            if (s == "--trace" && i + 1 < argc) cfg.tracePath = argv[++i];
+            if (s == "--alloc-stats") cfg.allocStats = true;
+        }
+        // Sin --seed cada partida es distinta, pero la semilla elegida se registra igualmente
+        // en el log para poder reproducirla
+        if (!seedGiven) cfg.seed = static_cast<unsigned int>(time(nullptr));
+        if (cfg.recordPath == "*") cfg.recordPath = "logs/run_" + std::to_string(cfg.seed) + ".replay";
+        if (cfg.replaySpeed <= 0.0f) cfg.replaySpeed = 1.0f;
+        cfg.ai = AIParams::FromEnv();
+        return cfg;
+    }
+};
+
+// Métricas de una partida: los mismos campos que SaveGameHistoryEntry escribe en logs/run_<seed>.json
+struct RunMetrics {
+    int seed = 0;
+    double durationSeconds = 0.0;
+    int maxLevel = 0;
+    int lives = 0;
+    int score = 0;
+    int powerupsCollected = 0;
+    int enemyHitsTaken = 0;
+    int shotsFired = 0;
+    double timeIdle = 0.0;
+    int powerupPickupCount = 0;
+    double powerupPickupLatencyAvg = 0.0;
+    // true si la partida se cortó por GameConfig::maxSimSeconds en lugar de terminar sola
+    bool timedOut = false;
+};
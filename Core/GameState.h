@@ -0,0 +1,109 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <type_traits>
+
+// Snapshot completo de una partida (Game::SaveState / Game::RestoreState).
+// Es un único buffer contiguo de bytes: copiarlo es un memcpy, y no contiene punteros
+// (ni SDL_Surface*, ni controladores): los edificios se guardan como máscaras de bits
+// sobre su imagen original. Sólo es válido para el mismo build que lo generó.
+struct GameState {
+    std::vector<uint8_t> bytes;
+
+    size_t Size() const { return bytes.size(); }
+    bool Empty() const { return bytes.empty(); }
+};
+
+// Escritura secuencial de valores trivialmente copiables al final de un buffer
+class StateWriter {
+public:
+    explicit StateWriter(std::vector<uint8_t>& out) : buf(out) {}
+
+    template <typename T>
+    void Put(const T& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "StateWriter::Put requires a trivially copyable type");
+        PutBytes(&v, sizeof(T));
+    }
+
+    void PutBytes(const void* data, size_t n) {
+        if (n == 0) return;
+        size_t at = buf.size();
+        buf.resize(at + n);
+        std::memcpy(buf.data() + at, data, n);
+    }
+
+    // Reserva n bytes al final y devuelve el puntero para rellenarlos directamente
+    uint8_t* Append(size_t n) {
+        size_t at = buf.size();
+        buf.resize(at + n);
+        return buf.data() + at;
+    }
+
+    // Tamaño (uint32) + elementos en bruto
+    template <typename T>
+    void PutVector(const std::vector<T>& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "StateWriter::PutVector requires a trivially copyable type");
+        Put<uint32_t>((uint32_t)v.size());
+        PutBytes(v.data(), v.size() * sizeof(T));
+    }
+
+    size_t Position() const { return buf.size(); }
+
+private:
+    std::vector<uint8_t>& buf;
+};
+
+// Lectura secuencial; cualquier lectura fuera de rango deja el reader en estado !Ok()
+class StateReader {
+public:
+    StateReader(const uint8_t* data, size_t size) : data(data), size(size) {}
+
+    template <typename T>
+    bool Get(T& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "StateReader::Get requires a trivially copyable type");
+        return GetBytes(&v, sizeof(T));
+    }
+
+    bool GetBytes(void* out, size_t n) {
+        if (!ok || n > size - pos) { ok = false; return false; }
+        if (n) std::memcpy(out, data + pos, n);
+        pos += n;
+        return true;
+    }
+
+    // Puntero a los siguientes n bytes (sin copiarlos); nullptr si no hay suficientes
+    const uint8_t* Take(size_t n) {
+        if (!ok || n > size - pos) { ok = false; return nullptr; }
+        const uint8_t* p = data + pos;
+        pos += n;
+        return p;
+    }
+
+    template <typename T>
+    bool GetVector(std::vector<T>& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "StateReader::GetVector requires a trivially copyable type");
+        uint32_t n = 0;
+        if (!Get(n)) return false;
+        if ((size_t)n > (size - pos) / (sizeof(T) ? sizeof(T) : 1)) { ok = false; return false; }
+        v.resize(n);
+        return GetBytes(v.data(), (size_t)n * sizeof(T));
+    }
+
+    // Sub-reader sobre los siguientes n bytes (para bloques con longitud prefijada)
+    StateReader Sub(size_t n) {
+        if (!ok || n > size - pos) { ok = false; return StateReader(nullptr, 0); }
+        StateReader r(data + pos, n);
+        pos += n;
+        return r;
+    }
+
+    bool Ok() const { return ok; }
+    bool AtEnd() const { return pos == size; }
+
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t pos = 0;
+    bool ok = true;
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Observations.h"
+#include "GameState.h"
 
 class IPlayerController {
 public:
@@ -11,4 +12,8 @@ public:
     virtual bool WantsFire() const = 0;
     virtual bool WantsUseShield() const = 0;
     virtual void Observe(const WorldObservation& obs) { (void)obs; }
+    // Estado interno que influye en el siguiente paso (decisiones pendientes), para
+    // snapshots de Game. Por defecto el controlador no tiene estado que guardar.
+    virtual void SaveState(StateWriter& w) const { (void)w; }
+    virtual bool RestoreState(StateReader& r) { (void)r; return true; }
 };
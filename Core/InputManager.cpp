@@ -2,8 +2,6 @@
 #include <SDL3/SDL.h>
 #include <iostream>
 
-extern bool g_running;
-
 void InputManager::Update() {
     // Usar el estado actual del teclado para permitir combinaciones (mover y disparar simultáneo)
     const auto state = SDL_GetKeyboardState(nullptr);
@@ -0,0 +1,157 @@
+#include "Log.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+// Límite de líneas por segundo de cada categoría. Las de combate (colisiones, edificios)
+// pueden disparar decenas de mensajes en un frame; las de arranque casi nunca llegan al límite.
+namespace LogCat {
+    LogCategory Game("Game", 50);
+    LogCategory Collision("Collision", 20);
+    LogCategory Enemies("EnemyManager", 20);
+    LogCategory Skyscraper("Skyscraper", 10);
+    LogCategory Assets("Assets", 100);
+    LogCategory Replay("Replay", 50);
+}
+
+static const char* LevelTag(LogLevel level) {
+    switch (level) {
+        case LogLevel::Warn: return "WARN ";
+        case LogLevel::Error: return "ERROR ";
+        case LogLevel::Debug: return "debug ";
+        case LogLevel::Trace: return "trace ";
+        default: return "";
+    }
+}
+
+static const auto kLoggerStart = std::chrono::steady_clock::now();
+
+Logger& Logger::Get() {
+    static Logger instance;
+    return instance;
+}
+
+Logger::Logger() : queue(new Entry[QueueSize]) {
+    for (size_t i = 0; i < QueueSize; ++i) queue[i].sequence.store(i, std::memory_order_relaxed);
+    writer = std::thread(&Logger::WriterLoop, this);
+}
+
+Logger::~Logger() {
+    stop.store(true, std::memory_order_release);
+    if (writer.joinable()) writer.join();
+}
+
+bool Logger::ParseLevel(const std::string& s, LogLevel& out) {
+    if (s == "trace") out = LogLevel::Trace;
+    else if (s == "debug") out = LogLevel::Debug;
+    else if (s == "info") out = LogLevel::Info;
+    else if (s == "warn") out = LogLevel::Warn;
+    else if (s == "error") out = LogLevel::Error;
+    else if (s == "off") out = LogLevel::Off;
+    else return false;
+    return true;
+}
+
+int64_t Logger::NowSeconds() const {
+    return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - kLoggerStart).count();
+}
+
+bool Logger::ShouldLog(LogLevel level, LogCategory& cat) {
+    if ((int)level < runtimeLevel.load(std::memory_order_relaxed)) return false;
+    // Warnings y errores no se limitan nunca
+    if (level >= LogLevel::Warn) return true;
+
+    int64_t now = NowSeconds();
+    int64_t window = cat.window.load(std::memory_order_relaxed);
+    if (window != now && cat.window.compare_exchange_strong(window, now, std::memory_order_relaxed)) {
+        // Empieza un segundo nuevo: quien gana el CAS reinicia el contador y resume lo descartado
+        cat.count.store(0, std::memory_order_relaxed);
+        int skipped = cat.suppressed.exchange(0, std::memory_order_relaxed);
+        if (skipped > 0) {
+            char note[64];
+            int n = std::snprintf(note, sizeof(note), "(%d messages suppressed)", skipped);
+            Enqueue(LogLevel::Info, cat.name, note, (size_t)n);
+        }
+    }
+    if (cat.count.fetch_add(1, std::memory_order_relaxed) < cat.maxPerSecond) return true;
+    cat.suppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void Logger::Push(LogLevel level, const LogCategory& cat, const LogLine& line) {
+    Enqueue(level, cat.name, line.Data(), line.Size());
+}
+
+void Logger::Enqueue(LogLevel level, const char* category, const char* text, size_t len) {
+    uint64_t pos = tail.load(std::memory_order_relaxed);
+    Entry* e = nullptr;
+    for (;;) {
+        e = &queue[pos & (QueueSize - 1)];
+        uint64_t seq = e->sequence.load(std::memory_order_acquire);
+        int64_t diff = (int64_t)seq - (int64_t)pos;
+        if (diff == 0) {
+            if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            // Cola llena: el escritor va por detrás; descartar antes que bloquear el frame
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            pos = tail.load(std::memory_order_relaxed);
+        }
+    }
+    if (len > MaxText) len = MaxText;
+    e->level = level;
+    e->category = category;
+    e->length = (uint16_t)len;
+    std::memcpy(e->text, text, len);
+    e->sequence.store(pos + 1, std::memory_order_release);
+}
+
+void Logger::WriterLoop() {
+    std::string line;
+    uint64_t reportedDrops = 0;
+    for (;;) {
+        bool wrote = false;
+        uint64_t pos = head.load(std::memory_order_relaxed);
+        for (;;) {
+            Entry& e = queue[pos & (QueueSize - 1)];
+            if (e.sequence.load(std::memory_order_acquire) != pos + 1) break;
+            line.clear();
+            line += '[';
+            line += e.category;
+            line += "] ";
+            line += LevelTag(e.level);
+            line.append(e.text, e.length);
+            line += '\n';
+            std::FILE* out = (e.level >= LogLevel::Warn) ? stderr : stdout;
+            std::fwrite(line.data(), 1, line.size(), out);
+            // Liberar el hueco para la siguiente vuelta de la cola
+            e.sequence.store(pos + QueueSize, std::memory_order_release);
+            ++pos;
+            head.store(pos, std::memory_order_release);
+            wrote = true;
+        }
+        uint64_t drops = dropped.load(std::memory_order_relaxed);
+        if (drops != reportedDrops) {
+            std::fprintf(stderr, "[Log] WARN queue full, %llu messages dropped so far\n", (unsigned long long)drops);
+            reportedDrops = drops;
+            wrote = true;
+        }
+        if (wrote) {
+            std::fflush(stdout);
+            continue;
+        }
+        if (stop.load(std::memory_order_acquire)) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void Logger::Flush() {
+    // Esperar a que el escritor alcance todo lo reservado hasta ahora
+    uint64_t target = tail.load(std::memory_order_acquire);
+    while (head.load(std::memory_order_acquire) < target) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::fflush(stdout);
+    std::fflush(stderr);
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+
+// Logger asíncrono por niveles y categorías.
+//   LOG_INFO(Collision, "PowerUp collected: restored " << n << " skyscrapers");
+// La línea se formatea en el hilo que llama (en un buffer de la pila, sin reservar memoria)
+// y se encola en una cola MPSC sin locks;
+// un hilo de fondo la escribe en consola ("[Categoria] texto"). Así los frames con mucho
+// combate no se bloquean en std::endl. Si la cola se llena la línea se descarta (y se cuenta).
+//
+// - Niveles por debajo de SPACEINVADERS_LOG_LEVEL desaparecen en compilación
+//   (por defecto se compila hasta Info; -DSPACEINVADERS_LOG_LEVEL=1 incluye Debug).
+// - En ejecución, Logger::SetLevel (--log-level) filtra además por nivel.
+// - Cada categoría tiene un máximo de líneas por segundo; el resto se resume en
+//   "(N messages suppressed)" al empezar el segundo siguiente.
+enum class LogLevel : int { Trace = 0, Debug = 1, Info = 2, Warn = 3, Error = 4, Off = 5 };
+
+#ifndef SPACEINVADERS_LOG_LEVEL
+#define SPACEINVADERS_LOG_LEVEL 2
+#endif
+
+struct LogCategory {
+    const char* name;
+    int maxPerSecond;
+    // Ventana de rate limiting (segundos de reloj desde el arranque del logger)
+    std::atomic<int64_t> window{-1};
+    std::atomic<int> count{0};
+    std::atomic<int> suppressed{0};
+
+    LogCategory(const char* name, int maxPerSecond) : name(name), maxPerSecond(maxPerSecond) {}
+};
+
+// Categorías del juego (Log.cpp fija el límite de cada una)
+namespace LogCat {
+    extern LogCategory Game;
+    extern LogCategory Collision;
+    extern LogCategory Enemies;
+    extern LogCategory Skyscraper;
+    extern LogCategory Assets;
+    extern LogCategory Replay;
+}
+
+// Longitud máxima de una línea (lo que no cabe se trunca)
+constexpr size_t kLogMaxText = 232;
+
+// Línea de log en formación: streambuf sobre un buffer fijo, para que LOG_* no cree
+// std::string/ostringstream en cada mensaje
+class LogLine : public std::streambuf {
+public:
+    LogLine() : stream(this) { setp(buf, buf + kLogMaxText); }
+    std::ostream& Stream() { return stream; }
+    const char* Data() const { return buf; }
+    size_t Size() const { return (size_t)(pptr() - pbase()); }
+
+private:
+    char buf[kLogMaxText];
+    std::ostream stream;
+};
+
+class Logger {
+public:
+    static Logger& Get();
+    ~Logger();
+
+    void SetLevel(LogLevel level) { runtimeLevel.store((int)level, std::memory_order_relaxed); }
+    LogLevel GetLevel() const { return (LogLevel)runtimeLevel.load(std::memory_order_relaxed); }
+    // "trace" | "debug" | "info" | "warn" | "error" | "off"; false si no se reconoce
+    static bool ParseLevel(const std::string& s, LogLevel& out);
+
+    // Filtro de nivel + rate limit de la categoría; true si hay que formatear y encolar
+    bool ShouldLog(LogLevel level, LogCategory& cat);
+    void Push(LogLevel level, const LogCategory& cat, const LogLine& line);
+    // Espera a que el hilo escritor vacíe la cola (antes de salir o de escribir directo a consola)
+    void Flush();
+    uint64_t Dropped() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    Logger();
+    void WriterLoop();
+    void Enqueue(LogLevel level, const char* category, const char* text, size_t len);
+    int64_t NowSeconds() const;
+
+    static constexpr size_t QueueSize = 4096;   // potencia de 2
+    static constexpr size_t MaxText = kLogMaxText;
+    struct Entry {
+        std::atomic<uint64_t> sequence;
+        LogLevel level;
+        const char* category;
+        uint16_t length;
+        char text[MaxText];
+    };
+    // Cola acotada de Vyukov: los productores reservan hueco con un CAS sobre tail,
+    // el único consumidor (WriterLoop) avanza head
+    std::unique_ptr<Entry[]> queue;
+    std::atomic<uint64_t> tail{0};
+    std::atomic<uint64_t> head{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<int> runtimeLevel{(int)LogLevel::Info};
+    std::atomic<bool> stop{false};
+    std::thread writer;
+};
+
+#define LOG_AT(lvl, cat, msg)                                                          \
+    do {                                                                               \
+        if constexpr ((int)(lvl) >= SPACEINVADERS_LOG_LEVEL) {                         \
+            if (Logger::Get().ShouldLog((lvl), LogCat::cat)) {                         \
+                LogLine logLine_;                                                      \
+                logLine_.Stream() << msg;                                              \
+                Logger::Get().Push((lvl), LogCat::cat, logLine_);                      \
+            }                                                                          \
+        }                                                                              \
+    } while (0)
+
+#define LOG_TRACE(cat, msg) LOG_AT(LogLevel::Trace, cat, msg)
+#define LOG_DEBUG(cat, msg) LOG_AT(LogLevel::Debug, cat, msg)
+#define LOG_INFO(cat, msg)  LOG_AT(LogLevel::Info, cat, msg)
+#define LOG_WARN(cat, msg)  LOG_AT(LogLevel::Warn, cat, msg)
+#define LOG_ERROR(cat, msg) LOG_AT(LogLevel::Error, cat, msg)
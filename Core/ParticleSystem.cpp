@@ -1,28 +1,27 @@
 #include "ParticleSystem.h"
 #include <algorithm>
-#include <cstdlib>
 #include <cmath>
 
-ParticleSystem::ParticleSystem() {}
+ParticleSystem::ParticleSystem(Rng& rng_) : rng(rng_) {}
 
 ParticleSystem::~ParticleSystem() {}
 
 void ParticleSystem::CreateExplosion(float x, float y, int cantidad) {
     for (int i = 0; i < cantidad; ++i) {
         // Ángulo aleatorio en todas las direcciones
-        float angle = (float)(rand() % 360) * 3.14159f / 180.0f;
+        float angle = (float)rng.Range(360) * 3.14159f / 180.0f;
         
         // Velocidad aleatoria
-        float speed = 30.0f + rand() % 70;
+        float speed = 30.0f + rng.Range(70);
         float vx = cos(angle) * speed;
         float vy = sin(angle) * speed;
         
         // Tiempo de vida aleatorio
-        float life = 0.3f + (rand() % 50) / 100.0f;
+        float life = 0.3f + rng.Range(50) / 100.0f;
         
         // Color amarillo-naranja para explosión
         float r = 1.0f;  // Rojo completo
-        float g = 0.5f + (rand() % 50) / 100.0f;  // Verde variable (amarillo-naranja)
+        float g = 0.5f + rng.Range(50) / 100.0f;  // Verde variable (amarillo-naranja)
         float b = 0.0f;  // Sin azul
         float a = 1.0f;  // Opacidad completa
         
@@ -55,18 +54,14 @@ void ParticleSystem::Update(float dt) {
     );
 }
 
-void ParticleSystem::Render(SDL_Renderer* renderer) {
+void ParticleSystem::Render(SpriteBatch& batch) {
     for (const auto& p : particles) {
-        // Establecer color con transparencia
-        SDL_SetRenderDrawColor(renderer, 
-            (Uint8)(p.r * 255), 
-            (Uint8)(p.g * 255), 
-            (Uint8)(p.b * 255), 
-            (Uint8)(p.a * 255));
-        
+        // Color con transparencia (mismo redondeo a 8 bits que SDL_SetRenderDrawColor)
+        SDL_Color color = { (Uint8)(p.r * 255), (Uint8)(p.g * 255), (Uint8)(p.b * 255), (Uint8)(p.a * 255) };
+
         // Dibujar partícula como pequeño rectángulo
         SDL_FRect rect = { p.x - 1, p.y - 1, 2.0f, 2.0f };
-        SDL_RenderFillRect(renderer, &rect);
+        batch.FillRect(rect, color);
     }
 }
 
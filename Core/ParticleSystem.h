@@ -1,6 +1,9 @@
 #pragma once
 #include <vector>
 #include <SDL3/SDL.h>
+#include "Rng.h"
+#include "GameState.h"
+#include "SpriteBatch.h"
 
 struct Particle {
     float x, y;         // Posición
@@ -11,16 +14,21 @@ struct Particle {
 
 class ParticleSystem {
 public:
-    ParticleSystem();
+    // rng: stream de partículas de la partida (propiedad de Game)
+    explicit ParticleSystem(Rng& rng);
     ~ParticleSystem();
 
     // Crear explosión de partículas en una posición
     void CreateExplosion(float x, float y, int cantidad = 15);
     
     void Update(float dt);
-    void Render(SDL_Renderer* renderer);
+    void Render(SpriteBatch& batch);
     void Clear();
+    // Snapshot (Game::SaveState)
+    void SaveState(StateWriter& w) const { w.PutVector(particles); }
+    bool RestoreState(StateReader& r) { return r.GetVector(particles); }
 
 private:
+    Rng& rng;
     std::vector<Particle> particles;
 };
@@ -3,6 +3,7 @@
 Player::Player() {
     // Updated to match player sprite size (45x43)
     rect = { 400, 550, 45, 43 };
+    prevRect = rect;
     speed = 300.0f; // velocidad en píxeles por segundo
 }
 
@@ -20,15 +21,16 @@ void Player::Update(float dt) {
     }
 }
 
-void Player::Render(SDL_Renderer* renderer) {
+void Player::Render(SDL_Renderer* renderer, float alpha) {
+    SDL_FRect r = RenderRect(alpha);
     SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
-    SDL_RenderFillRect(renderer, &rect);
+    SDL_RenderFillRect(renderer, &r);
 
     // Dibujar escudo si activo con alpha
     if (shieldActive) {
         Uint8 a = static_cast<Uint8>(255 * shieldAlpha);
         SDL_SetRenderDrawColor(renderer, 0, 191, 255, a); // color cyan claro con alpha
-        SDL_FRect s = { rect.x - 5.0f, rect.y - 5.0f, rect.w + 10.0f, rect.h + 10.0f };
+        SDL_FRect s = { r.x - 5.0f, r.y - 5.0f, r.w + 10.0f, r.h + 10.0f };
         SDL_RenderFillRect(renderer, &s);
     }
 }
@@ -55,3 +57,16 @@ void Player::ShieldHit() {
         shieldAlpha *= 0.6f;
     }
 }
+
+void Player::SaveState(StateWriter& w) const {
+    w.Put(rect); w.Put(prevRect);
+    w.Put(shieldActive); w.Put(shieldAlpha); w.Put(shieldHp); w.Put(shieldTimer);
+    w.Put(speed);
+}
+
+bool Player::RestoreState(StateReader& r) {
+    r.Get(rect); r.Get(prevRect);
+    r.Get(shieldActive); r.Get(shieldAlpha); r.Get(shieldHp); r.Get(shieldTimer);
+    r.Get(speed);
+    return r.Ok();
+}
@@ -1,12 +1,13 @@
 #pragma once
 #include "Entity.h"
 #include "IPlayerController.h"
+#include "GameState.h"
 
 class Player : public Entity {
 public:
     Player();
     void Update(float dt) override;
-    void Render(SDL_Renderer* renderer) override;
+    void Render(SDL_Renderer* renderer, float alpha = 1.0f) override;
     void Move(float dir, float dt);
     // Escudo del jugador
     bool shieldActive = false;
@@ -14,6 +15,9 @@ public:
     int shieldHp = 0;
     float shieldTimer = 0.0f;
     void ShieldHit();
+    // Snapshot (Game::SaveState). El controlador no se incluye: Game guarda su estado aparte
+    void SaveState(StateWriter& w) const;
+    bool RestoreState(StateReader& r);
 
     // Inyectar controlador (puede ser HumanController o AIController)
     void SetController(IPlayerController* c) { controller = c; }
@@ -0,0 +1,150 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "GameState.h"
+
+// Reparto de huecos de un pool de capacidad fija (balas, powerups).
+// - Acquire/Release en O(1) con una pila de huecos libres. Un hueco no cambia de índice
+//   mientras está vivo y los arrays del pool se reservan una sola vez: nada se reubica ni
+//   se mueve durante la partida, y en régimen estable no hay reservas de memoria.
+// - Live() es la lista densa de huecos en orden de alta; los bucles recorren sólo eso en
+//   lugar de toda la capacidad.
+// Release sólo marca el hueco como muerto: Compact (una vez por paso) lo quita de Live()
+// sin alterar el orden del resto y lo devuelve a la pila libre. Así un hueco no se reutiliza
+// en el mismo paso en que muere, y el orden de recorrido (y con él el de las colisiones)
+// es siempre el de creación, igual que con el antiguo vector + erase(remove_if).
+class SlotPool {
+public:
+    static constexpr uint32_t Invalid = 0xFFFFFFFFu;
+
+    explicit SlotPool(uint32_t capacity) : capacity(capacity) {
+        alive.reserve(capacity);
+        freeSlots.reserve(capacity);
+        live.reserve(capacity);
+        Clear();
+    }
+
+    // Hueco libre o Invalid si el pool está lleno (se cuenta en Rejected)
+    uint32_t Acquire() {
+        if (freeSlots.empty()) {
+            ++rejected;
+            return Invalid;
+        }
+        uint32_t s = freeSlots.back();
+        freeSlots.pop_back();
+        alive[s] = 1;
+        live.push_back(s);
+        return s;
+    }
+    void Release(uint32_t s) { alive[s] = 0; }
+    bool IsAlive(uint32_t s) const { return alive[s] != 0; }
+
+    // Quitar de Live() los huecos liberados (estable) y devolverlos a la pila libre
+    void Compact() {
+        size_t out = 0;
+        for (uint32_t s : live) {
+            if (alive[s]) live[out++] = s;
+            else freeSlots.push_back(s);
+        }
+        live.resize(out);
+    }
+
+    void Clear() {
+        alive.assign(capacity, 0);
+        live.clear();
+        freeSlots.clear();
+        // El hueco 0 sale el primero
+        for (uint32_t s = capacity; s > 0; --s) freeSlots.push_back(s - 1);
+    }
+
+    const std::vector<uint32_t>& Live() const { return live; }
+    size_t LiveCount() const { return live.size(); }
+    uint32_t Capacity() const { return capacity; }
+    bool Full() const { return freeSlots.empty(); }
+    // Acquire fallidos desde que se creó el pool (Clear no lo reinicia): Game lo resume al final
+    uint64_t Rejected() const { return rejected; }
+
+private:
+    uint32_t capacity;
+    uint64_t rejected = 0;
+    std::vector<uint8_t> alive;
+    std::vector<uint32_t> freeSlots;
+    std::vector<uint32_t> live;
+};
+
+// Pool de objetos de capacidad fija sobre SlotPool (powerups). Se recorre con range-for
+// sobre los huecos de Live(); los objetos liberados pero aún no compactados siguen
+// apareciendo, igual que los inactivos del vector de antes.
+template <typename T>
+class ObjectPool {
+public:
+    explicit ObjectPool(uint32_t capacity) : items(capacity), slots(capacity) {}
+
+    // Objeto del hueco reservado (sin reinicializar) o nullptr si el pool está lleno
+    T* Acquire() {
+        uint32_t s = slots.Acquire();
+        return s == SlotPool::Invalid ? nullptr : &items[s];
+    }
+    // Liberar los objetos para los que dead(obj) es true y compactar
+    template <typename Pred>
+    void ReleaseIf(Pred dead) {
+        for (uint32_t s : slots.Live()) {
+            if (slots.IsAlive(s) && dead(items[s])) slots.Release(s);
+        }
+        slots.Compact();
+    }
+    void Clear() { slots.Clear(); }
+
+    // Snapshot: los objetos de los huecos vivos en orden de Live(). Al restaurar se vuelven
+    // a repartir desde el hueco 0; el índice concreto no importa, sólo el orden.
+    void SaveState(StateWriter& w) const {
+        uint32_t n = 0;
+        for (uint32_t s : slots.Live()) n += slots.IsAlive(s) ? 1 : 0;
+        w.Put(n);
+        for (uint32_t s : slots.Live()) {
+            if (slots.IsAlive(s)) w.Put(items[s]);
+        }
+    }
+    bool RestoreState(StateReader& r) {
+        uint32_t n = 0;
+        if (!r.Get(n) || n > slots.Capacity()) return false;
+        slots.Clear();
+        for (uint32_t i = 0; i < n; ++i) {
+            if (!r.Get(*Acquire())) return false;
+        }
+        return true;
+    }
+
+    size_t Size() const { return slots.LiveCount(); }
+    uint32_t Capacity() const { return slots.Capacity(); }
+    uint64_t Rejected() const { return slots.Rejected(); }
+
+    // Acceso por hueco (los huecos no se mueven: un índice guardado sigue valiendo hasta Compact)
+    const std::vector<uint32_t>& Live() const { return slots.Live(); }
+    T& At(uint32_t s) { return items[s]; }
+    const T& At(uint32_t s) const { return items[s]; }
+
+    template <typename P, typename Obj>
+    class Iter {
+    public:
+        Iter(P* pool, const uint32_t* at) : pool(pool), at(at) {}
+        Obj& operator*() const { return pool->items[*at]; }
+        Obj* operator->() const { return &pool->items[*at]; }
+        Iter& operator++() { ++at; return *this; }
+        bool operator!=(const Iter& o) const { return at != o.at; }
+    private:
+        P* pool;
+        const uint32_t* at;
+    };
+    using iterator = Iter<ObjectPool, T>;
+    using const_iterator = Iter<const ObjectPool, const T>;
+
+    iterator begin() { return iterator(this, slots.Live().data()); }
+    iterator end() { return iterator(this, slots.Live().data() + slots.LiveCount()); }
+    const_iterator begin() const { return const_iterator(this, slots.Live().data()); }
+    const_iterator end() const { return const_iterator(this, slots.Live().data() + slots.LiveCount()); }
+
+private:
+    std::vector<T> items;
+    SlotPool slots;
+};
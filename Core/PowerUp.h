@@ -3,10 +3,13 @@
 #include <string>
 #include <random>
 #include "SpriteSheet.h"
+#include "SpriteBatch.h"
+#include "Pool.h"
 
 struct PowerUp {
     enum class Type { RestoreDefense, BulletTime, ExtraLife, HomingMissiles, Shield, ContinueFire };
     SDL_FRect rect;
+    SDL_FRect prevRect; // rect al inicio del último paso (interpolación de render)
     float vy = 120.0f; // velocidad de caída px/s
     Type type = Type::RestoreDefense;
     bool active = true;
@@ -14,12 +17,13 @@ struct PowerUp {
     PowerUp(float x=0, float y=0, Type t=Type::RestoreDefense) : type(t) {
     // Use 32x32 for scale 4 (8x8 tiles scaled x4 -> 32x32)
     rect = { x, y, 32.0f, 32.0f };
+        prevRect = rect;
         active = true;
-        spawnAbsTime = 0.0; // will be set by Game::SpawnPowerUp when spawned
+        spawnTime = 0.0; // will be set by Game::SpawnPowerUp when spawned
     }
 
-    // Absolute epoch seconds when spawned (for pickup time measurement)
-    double spawnAbsTime = 0.0;
+    // Simulated seconds (Game::GetSimTime) when spawned (for pickup time measurement)
+    double spawnTime = 0.0;
 
     void Update(float dt) {
         if (!active) return;
@@ -27,21 +31,12 @@ struct PowerUp {
         if (rect.y > 600.0f) active = false;
     }
 
-    void Render(SDL_Renderer* renderer) {
-        if (!active) return;
+    void SavePrevRect() { prevRect = rect; }
 
-        // Lazy-load the miscellaneous sprite sheet once.
-        static SpriteSheet miscSheet;
-        static bool miscLoaded = false;
-        if (!miscLoaded) {
-            // Path used elsewhere in repo (tools/spritetest). Tile size default 8x8.
-            std::string path = "assets/sprites/SpaceShooterAssetPack_Miscellaneous.png";
-            miscLoaded = miscSheet.Load(renderer, path, 8, 8);
-            if (!miscLoaded) {
-                // If loading fails, fallback to previous rectangle rendering with colors.
-                miscLoaded = false;
-            }
-        }
+    // miscSheet: sprite sheet de iconos (Renderer::GetMiscSheet); nullptr -> rectángulos de color
+    void Render(SpriteBatch& batch, SpriteSheet* miscSheet, float alpha = 1.0f) {
+        if (!active) return;
+        SDL_FRect r = { prevRect.x + (rect.x - prevRect.x) * alpha, prevRect.y + (rect.y - prevRect.y) * alpha, rect.w, rect.h };
 
         // Map PowerUp::Type to sprite sheet indices per user request:
         // 0 -> RestoreDefense
@@ -71,38 +66,43 @@ struct PowerUp {
             mappedIndex = choices[d(rng)];
         }
 
-        if (miscLoaded && miscSheet.GetTexture()) {
-            SDL_Rect src = miscSheet.GetSrcRect(mappedIndex);
+        if (miscSheet && miscSheet->GetTexture()) {
+            SDL_Rect src = miscSheet->GetSrcRect(mappedIndex);
             SDL_FRect srcF = {(float)src.x, (float)src.y, (float)src.w, (float)src.h};
             // Render with integer pixel scaling: draw as 16x16 (2x for 8x8 tiles)
             // Render at 32x32 (8x8 tiles scaled x4 -> 32x32)
             const float dstW = 32.0f;
             const float dstH = 32.0f;
-            SDL_FRect dstF = { rect.x + (rect.w - dstW) / 2.0f, rect.y + (rect.h - dstH) / 2.0f, dstW, dstH };
-            SDL_RenderTexture(renderer, miscSheet.GetTexture(), &srcF, &dstF);
+            SDL_FRect dstF = { r.x + (r.w - dstW) / 2.0f, r.y + (r.h - dstH) / 2.0f, dstW, dstH };
+            batch.Draw(miscSheet->GetTexture(), &srcF, dstF);
         } else {
             // Fallback: original colored rectangle rendering
+            SDL_Color color = {255, 255, 255, 255};
             switch (type) {
                 case Type::RestoreDefense:
-                    SDL_SetRenderDrawColor(renderer, 0, 255, 255, 255); // cyan
+                    color = {0, 255, 255, 255}; // cyan
                     break;
                 case Type::BulletTime:
-                    SDL_SetRenderDrawColor(renderer, 0, 0, 255, 255); // blue
+                    color = {0, 0, 255, 255}; // blue
                     break;
                 case Type::ExtraLife:
-                    SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255); // green
+                    color = {0, 255, 0, 255}; // green
                     break;
                 case Type::HomingMissiles:
-                    SDL_SetRenderDrawColor(renderer, 255, 165, 0, 255); // orange
+                    color = {255, 165, 0, 255}; // orange
                     break;
                 case Type::Shield:
-                    SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255); // yellow
+                    color = {255, 255, 0, 255}; // yellow
                     break;
                 case Type::ContinueFire:
-                    SDL_SetRenderDrawColor(renderer, 255, 0, 255, 255); // magenta
+                    color = {255, 0, 255, 255}; // magenta
                     break;
             }
-            SDL_RenderFillRect(renderer, &rect);
+            batch.FillRect(r, color);
         }
     }
 };
+
+// Powerups de la partida (Game): pool de capacidad fija, como las balas. Nunca hay más
+// de unos pocos en pantalla; si se llena, el drop se pierde.
+using PowerUpPool = ObjectPool<PowerUp>;
@@ -0,0 +1,81 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Profiler por fases del frame (--trace fichero.json).
+// PROFILE_SCOPE("nombre") mide el bloque que lo contiene y deja una muestra (nombre, inicio,
+// duración, hilo) en un ring buffer de tamaño fijo. Escribir una muestra es un fetch_add
+// atómico + una copia: sin locks ni reservas de memoria, así que vale también con varias
+// partidas en paralelo (SimulationRunner). Desactivado cuesta una lectura atómica por scope.
+// WriteChromeTrace genera el JSON de chrome://tracing / Perfetto (ui.perfetto.dev).
+//
+// Los nombres deben ser literales (se guarda el puntero, no una copia).
+// Compilar con -DSPACEINVADERS_NO_PROFILE elimina los scopes por completo.
+class Profiler {
+public:
+    struct Sample {
+        const char* name;
+        int64_t startNs;   // desde Enable()
+        int64_t durationNs;
+        uint32_t thread;   // índice pequeño por hilo (1, 2, ...)
+    };
+
+    static Profiler& Get();
+
+    // Reserva el ring buffer (capacity muestras; cuando se llena se sobrescriben las más antiguas)
+    void Enable(size_t capacity = 1 << 18);
+    void Disable() { enabled.store(false, std::memory_order_relaxed); }
+    bool IsEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    void Record(const char* name, int64_t startNs, int64_t durationNs);
+    int64_t NowNs() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - origin).count();
+    }
+
+    // Copia de las muestras vivas en orden de escritura. Llamar con los hilos que miden parados.
+    std::vector<Sample> Snapshot() const;
+    // Muestras perdidas por desbordar el ring buffer
+    uint64_t Dropped() const;
+    bool WriteChromeTrace(const std::string& path) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+    Profiler() = default;
+    std::atomic<bool> enabled{false};
+    std::atomic<uint64_t> writeIndex{0};
+    std::vector<Sample> ring;
+    Clock::time_point origin;
+};
+
+// Mide desde la construcción hasta el final del scope
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) : name(name) {
+        Profiler& p = Profiler::Get();
+        active = p.IsEnabled();
+        if (active) start = p.NowNs();
+    }
+    ~ProfileScope() {
+        if (!active) return;
+        Profiler& p = Profiler::Get();
+        p.Record(name, start, p.NowNs() - start);
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    int64_t start = 0;
+    bool active = false;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#ifdef SPACEINVADERS_NO_PROFILE
+#define PROFILE_SCOPE(name) ((void)0)
+#else
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#endif
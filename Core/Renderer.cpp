@@ -1,14 +1,25 @@
 #include "Renderer.h"
 #include <iostream>
 #include <SDL3/SDL.h>
-#include <SDL3_image/SDL_image.h> // Make sure this path is correct for your setup
+#include "AssetCache.h"
+
+static const char* kEnemyTexturePath = "assets/base.png";
+static const char* kPlayerTexturePath = "assets/player.png";
+static const char* kShipsSheetPath = "assets/sprites/SpaceShooterAssetPack_Ships.png";
+static const char* kMiscSheetPath = "assets/sprites/SpaceShooterAssetPack_Miscellaneous.png";
 
 Renderer::Renderer() : window(nullptr), renderer(nullptr) {}
 
+std::vector<std::string> Renderer::AssetPaths() {
+    return { kEnemyTexturePath, kPlayerTexturePath, kShipsSheetPath, kMiscSheetPath };
+}
+
 Renderer::~Renderer() {
-    // Free loaded textures and quit SDL_image
-    if (enemyTexture) SDL_DestroyTexture(enemyTexture);
-    if (playerTexture) SDL_DestroyTexture(playerTexture);
+    // Soltar las texturas de la caché antes de destruir el renderer que las creó
+    AssetCache::Get().ReleaseTexture(enemyTexture);
+    AssetCache::Get().ReleaseTexture(playerTexture);
+    playerSheet.Unload();
+    miscSheet.Unload();
     if (renderer) SDL_DestroyRenderer(renderer);
     if (window) SDL_DestroyWindow(window);
 }
@@ -18,19 +29,26 @@ bool Renderer::Init() {
     if (renderer) {
         // Habilitar blending por defecto para poder dibujar colores con alfa
         SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+        // VSync marca el ritmo del bucle de render; la simulación avanza a paso fijo aparte
+        SDL_SetRenderVSync(renderer, 1);
         // Intentar cargar texturas necesarias
-        if (!LoadTexture("assets/base.png", enemyTexture)) {
+        if (!LoadTexture(kEnemyTexturePath, enemyTexture)) {
             std::cerr << "[Renderer] Warning: failed to load assets/base.png, enemies will be drawn as rects" << std::endl;
         }
         // Keep existing single-texture fallback
-        if (!LoadTexture("assets/player.png", playerTexture)) {
+        if (!LoadTexture(kPlayerTexturePath, playerTexture)) {
             std::cerr << "[Renderer] Warning: failed to load assets/player.png, player will be drawn as rect" << std::endl;
         }
         // Try to load player sprite sheet (8x8 tiles)
-        hasPlayerSheet = playerSheet.Load(renderer, "assets/sprites/SpaceShooterAssetPack_Ships.png", 8, 8);
+        hasPlayerSheet = playerSheet.Load(renderer, kShipsSheetPath, 8, 8);
         if (!hasPlayerSheet) {
             std::cerr << "[Renderer] Warning: failed to load player sprite sheet, falling back to player.png or rect" << std::endl;
         }
+        // Misc sheet (powerups y HUD). Antes se cargaba con statics locales en PowerUp::Render y el HUD
+        hasMiscSheet = miscSheet.Load(renderer, kMiscSheetPath, 8, 8);
+        if (!hasMiscSheet) {
+            std::cerr << "[Renderer] Warning: failed to load misc sprite sheet, powerups will be drawn as rects" << std::endl;
+        }
     }
     return window && renderer;
 }
@@ -66,10 +84,14 @@ bool Renderer::HasPlayerSheet() {
     return hasPlayerSheet;
 }
 
+SpriteSheet* Renderer::GetMiscSheet() {
+    return hasMiscSheet ? &miscSheet : nullptr;
+}
+
 bool Renderer::LoadTexture(const std::string& path, SDL_Texture*& outTex) {
     outTex = nullptr;
     if (!renderer) return false;
-    // Use IMG_LoadTexture to create the texture directly from file (no surface needed)
-    outTex = IMG_LoadTexture(renderer, path.c_str());
+    // Imagen decodificada por AssetCache (en segundo plano desde Game::Init); aquí sólo se sube
+    outTex = AssetCache::Get().AcquireTexture(renderer, path);
     return outTex != nullptr;
 }
@@ -1,7 +1,9 @@
 #pragma once
 #include <SDL3/SDL.h>
 #include <string>
+#include <vector>
 #include "SpriteSheet.h"
+#include "SpriteBatch.h"
 
 class Renderer {
 public:
@@ -17,6 +19,12 @@ public:
     // Sprite sheet accessors
     SpriteSheet* GetPlayerSheet();
     bool HasPlayerSheet();
+    // Misc sheet (iconos de powerups y de vida); nullptr si no se pudo cargar
+    SpriteSheet* GetMiscSheet();
+    // Imágenes que carga Init (para precargarlas en AssetCache antes de crear la ventana)
+    static std::vector<std::string> AssetPaths();
+    // Lote de quads de las entidades (balas, enemigos, partículas, powerups)
+    SpriteBatch& GetBatch() { return batch; }
 
 private:
     bool LoadTexture(const std::string& path, SDL_Texture*& outTex);
@@ -28,4 +36,8 @@ private:
     // Sprite sheet for player (8x8 tiles)
     SpriteSheet playerSheet;
     bool hasPlayerSheet = false;
+    // Sprite sheet misc (8x8 tiles): powerups y HUD
+    SpriteSheet miscSheet;
+    bool hasMiscSheet = false;
+    SpriteBatch batch;
 };
@@ -0,0 +1,99 @@
+#include "Replay.h"
+#include "GameState.h"
+#include <fstream>
+#include "Log.h"
+#include <iterator>
+
+static const uint32_t kReplayMagic = 0x50524953; // "SIRP"
+static const uint32_t kReplayVersion = 1;
+
+void Replay::Push(uint8_t bits) {
+    if (!runs.empty() && runs.back().bits == bits && runs.back().length < 0xFFFFFFFFu) {
+        runs.back().length++;
+    } else {
+        runs.push_back({ bits, 1 });
+    }
+    tickCount++;
+}
+
+bool Replay::Next(uint8_t& bits) {
+    while (cursorRun < runs.size() && cursorOffset >= runs[cursorRun].length) {
+        cursorRun++;
+        cursorOffset = 0;
+    }
+    if (cursorRun >= runs.size()) return false;
+    bits = runs[cursorRun].bits;
+    cursorOffset++;
+    return true;
+}
+
+bool Replay::Save(const std::string& path) const {
+    std::vector<uint8_t> buf;
+    StateWriter w(buf);
+    w.Put(kReplayMagic);
+    w.Put(kReplayVersion);
+    w.Put(seed);
+    w.Put(tickCount);
+    w.Put(finalScore);
+    w.Put(finalSimTime);
+    w.Put<uint32_t>((uint32_t)runs.size());
+    for (const Run& r : runs) {
+        w.Put(r.bits);
+        // Longitud en varint (7 bits por byte): la mayoría de runs caben en 1-2 bytes
+        uint32_t len = r.length;
+        while (len >= 0x80) {
+            w.Put<uint8_t>((uint8_t)(len | 0x80));
+            len >>= 7;
+        }
+        w.Put<uint8_t>((uint8_t)len);
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out.good()) {
+        LOG_ERROR(Replay, "Could not write " << path);
+        return false;
+    }
+    out.write((const char*)buf.data(), (std::streamsize)buf.size());
+    return out.good();
+}
+
+bool Replay::Load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.good()) {
+        LOG_ERROR(Replay, "Could not open " << path);
+        return false;
+    }
+    std::vector<uint8_t> buf((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    StateReader r(buf.data(), buf.size());
+    uint32_t magic = 0, version = 0, runCount = 0;
+    r.Get(magic); r.Get(version);
+    if (!r.Ok() || magic != kReplayMagic || version != kReplayVersion) {
+        LOG_ERROR(Replay, path << " is not a replay file (or wrong version)");
+        return false;
+    }
+    uint32_t ticks = 0;
+    r.Get(seed); r.Get(ticks); r.Get(finalScore); r.Get(finalSimTime); r.Get(runCount);
+    runs.clear();
+    tickCount = 0;
+    for (uint32_t i = 0; i < runCount && r.Ok(); ++i) {
+        Run run{ 0, 0 };
+        r.Get(run.bits);
+        uint8_t b = 0;
+        int shift = 0;
+        do {
+            if (!r.Get(b)) break;
+            run.length |= (uint32_t)(b & 0x7F) << shift;
+            shift += 7;
+        } while ((b & 0x80) && shift < 35);
+        runs.push_back(run);
+        tickCount += run.length;
+    }
+    if (!r.Ok() || tickCount != ticks) {
+        LOG_ERROR(Replay, path << " is truncated or corrupt");
+        runs.clear();
+        tickCount = 0;
+        return false;
+    }
+    Rewind();
+    return true;
+}
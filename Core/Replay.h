@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Replay de una partida: semilla + la entrada del jugador en cada tick de simulación
+// (izquierda/derecha/disparo, y "avanzar" cuando se pulsa una tecla en la pantalla de
+// transición de nivel). Como toda la aleatoriedad sale de la semilla (GameRng), volver a
+// aplicar la misma entrada reproduce la partida exacta, sin IA y sin ventana si se quiere.
+//
+// Formato (little-endian): "SIRP", versión, semilla, ticks, score y tiempo simulado finales
+// (para verificar la reproducción) y la entrada comprimida en runs RLE (bits + longitud varint).
+class Replay {
+public:
+    enum InputBits : uint8_t {
+        Left = 1 << 0,
+        Right = 1 << 1,
+        Fire = 1 << 2,
+        Advance = 1 << 3 // NextLevel pedido antes de este tick
+    };
+
+    uint32_t seed = 0;
+    // Resultado de la partida grabada (se rellena al terminar de grabar)
+    int32_t finalScore = 0;
+    double finalSimTime = 0.0;
+
+    // Grabación: añade la entrada de un tick
+    void Push(uint8_t bits);
+    // Reproducción: entrada del siguiente tick; false cuando se acaba la cinta
+    bool Next(uint8_t& bits);
+    void Rewind() { cursorRun = 0; cursorOffset = 0; }
+
+    uint32_t TickCount() const { return tickCount; }
+    size_t RunCount() const { return runs.size(); }
+
+    bool Save(const std::string& path) const;
+    bool Load(const std::string& path);
+
+private:
+    struct Run {
+        uint8_t bits;
+        uint32_t length;
+    };
+    std::vector<Run> runs;
+    uint32_t tickCount = 0;
+    size_t cursorRun = 0;
+    uint32_t cursorOffset = 0;
+};
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+
+// Generador PCG32 (O'Neill, pcg-random.org): 64 bits de estado, sembrable y muy barato.
+// Cada subsistema usa su propio stream (incremento distinto) para que consumir números
+// en uno no altere la secuencia de los demás. Sin estado global: varias simulaciones
+// en hilos distintos no comparten nada.
+class Rng {
+public:
+    Rng() { Seed(0, 0); }
+    Rng(uint64_t seed, uint64_t stream) { Seed(seed, stream); }
+
+    void Seed(uint64_t seed, uint64_t stream) {
+        state = 0u;
+        inc = (stream << 1u) | 1u;
+        NextU32();
+        state += seed;
+        NextU32();
+    }
+
+    uint32_t NextU32() {
+        uint64_t old = state;
+        state = old * 6364136223846793005ULL + inc;
+        uint32_t xorshifted = (uint32_t)(((old >> 18u) ^ old) >> 27u);
+        uint32_t rot = (uint32_t)(old >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+    }
+
+    // Entero uniforme en [0, n) (método de Lemire: multiplicación + rechazo, sin sesgo del módulo)
+    int Range(int n) {
+        if (n <= 1) return 0;
+        uint32_t bound = (uint32_t)n;
+        uint64_t m = (uint64_t)NextU32() * bound;
+        uint32_t low = (uint32_t)m;
+        if (low < bound) {
+            uint32_t threshold = (0u - bound) % bound;
+            while (low < threshold) {
+                m = (uint64_t)NextU32() * bound;
+                low = (uint32_t)m;
+            }
+        }
+        return (int)(m >> 32);
+    }
+
+    // Float uniforme en [0, 1)
+    float Float01() { return (NextU32() >> 8) * (1.0f / 16777216.0f); }
+
+    // Estado completo (para snapshots/replays)
+    uint64_t state = 0;
+    uint64_t inc = 1;
+};
+
+// Streams independientes por subsistema, propiedad de cada instancia de Game
+struct GameRng {
+    Rng enemies;    // decisiones de bosses
+    Rng enemyFire;  // elección de tirador en EnemyManager::FireRandomBullet
+    Rng drops;      // tiradas de powerups (CollisionManager y regla de nivel 1)
+    Rng particles;  // explosiones (sólo visual, pero también determinista)
+
+    void Seed(uint64_t seed) {
+        enemies.Seed(seed, 1);
+        enemyFire.Seed(seed, 2);
+        drops.Seed(seed, 3);
+        particles.Seed(seed, 4);
+    }
+};
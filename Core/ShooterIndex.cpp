@@ -0,0 +1,147 @@
+#include "ShooterIndex.h"
+#include <algorithm>
+#include <cmath>
+
+int ShooterIndex::ColumnOf(float x) {
+    // Dos enemigos a menos de Reach caen en el mismo cubo o en cubos contiguos (también al recortar)
+    return std::clamp((int)std::floor(x / Reach), 0, Columns - 1);
+}
+
+void ShooterIndex::Rebuild(const EnemyArray& enemies) {
+    for (int c = 0; c < Columns; ++c) columns[c].clear();
+    columnOf.assign(enemies.Size(), kNoColumn);
+    keyX.assign(enemies.Size(), 0.0f);
+    keyY.assign(enemies.Size(), 0.0f);
+    shooter.assign(enemies.Size(), 0);
+    shooters.clear();
+    tripleShotBoss = None;
+    for (size_t i = 0; i < enemies.Size(); ++i) {
+        if (enemies.alive[i]) OnSpawn(enemies, (uint32_t)i);
+        NoteBoss(enemies, (uint32_t)i);
+    }
+}
+
+void ShooterIndex::Insert(int col, uint32_t i, float y) {
+    std::vector<Member>& m = columns[col];
+    auto at = std::upper_bound(m.begin(), m.end(), y, [](float v, const Member& e) { return v > e.y; });
+    m.insert(at, Member{ i, y });
+}
+
+void ShooterIndex::Remove(int col, uint32_t i) {
+    std::vector<Member>& m = columns[col];
+    for (size_t k = 0; k < m.size(); ++k) {
+        if (m[k].index == i) {
+            m.erase(m.begin() + k);
+            return;
+        }
+    }
+}
+
+void ShooterIndex::MarkAround(int col) {
+    for (int c = std::max(col - 1, 0); c <= std::min(col + 1, Columns - 1); ++c) dirty[c] = true;
+    anyDirty = true;
+}
+
+void ShooterIndex::OnSpawn(const EnemyArray& enemies, uint32_t i) {
+    if (i >= columnOf.size()) {
+        columnOf.resize(i + 1, kNoColumn);
+        keyX.resize(i + 1, 0.0f);
+        keyY.resize(i + 1, 0.0f);
+        shooter.resize(i + 1, 0);
+    }
+    if (columnOf[i] != kNoColumn) OnDeath(i);
+    const int col = ColumnOf(enemies.x[i]);
+    columnOf[i] = (int16_t)col;
+    keyX[i] = enemies.x[i];
+    keyY[i] = enemies.y[i];
+    Insert(col, i, keyY[i]);
+    MarkAround(col);
+}
+
+void ShooterIndex::OnDeath(uint32_t i) {
+    if (i >= columnOf.size() || columnOf[i] == kNoColumn) return;
+    const int col = columnOf[i];
+    Remove(col, i);
+    columnOf[i] = kNoColumn;
+    SetShooter(i, false);
+    // Los de encima pueden haber quedado al descubierto
+    MarkAround(col);
+}
+
+void ShooterIndex::OnMove(const EnemyArray& enemies, uint32_t i) {
+    const bool indexed = i < columnOf.size() && columnOf[i] != kNoColumn;
+    if (!enemies.alive[i]) {
+        if (indexed) OnDeath(i);
+        return;
+    }
+    if (!indexed) {
+        OnSpawn(enemies, i);
+        return;
+    }
+    if (enemies.x[i] == keyX[i] && enemies.y[i] == keyY[i]) return;
+    const int from = columnOf[i];
+    const int to = ColumnOf(enemies.x[i]);
+    Remove(from, i);
+    columnOf[i] = (int16_t)to;
+    keyX[i] = enemies.x[i];
+    keyY[i] = enemies.y[i];
+    Insert(to, i, keyY[i]);
+    MarkAround(from);
+    if (to != from) MarkAround(to);
+}
+
+void ShooterIndex::NoteBoss(const EnemyArray& enemies, uint32_t i) {
+    if (tripleShotBoss != None || !enemies.alive[i] || !enemies.IsBoss(i)) return;
+    const EnemyCold& c = enemies.cold[i];
+    if (c.bossAction == BossAction::TripleShot && c.actionTimer > 0.0f) tripleShotBoss = i;
+}
+
+bool ShooterIndex::IsBottom(const EnemyArray& enemies, uint32_t i) const {
+    const int col = columnOf[i];
+    const float x = enemies.x[i];
+    const float y = keyY[i];
+    for (int c = std::max(col - 1, 0); c <= std::min(col + 1, Columns - 1); ++c) {
+        // Ordenados de abajo arriba: basta con los que están más abajo que i
+        for (const Member& m : columns[c]) {
+            if (m.y <= y) break;
+            if (std::fabs(enemies.x[m.index] - x) < Reach) return false;
+        }
+    }
+    return true;
+}
+
+void ShooterIndex::SetShooter(uint32_t i, bool on) {
+    if ((shooter[i] != 0) == on) return;
+    shooter[i] = on ? 1 : 0;
+    auto at = std::lower_bound(shooters.begin(), shooters.end(), i);
+    if (on) shooters.insert(at, i);
+    else shooters.erase(at);
+}
+
+void ShooterIndex::Refresh(const EnemyArray& enemies) {
+    if (!anyDirty) return;
+    for (int c = 0; c < Columns; ++c) {
+        if (!dirty[c]) continue;
+        dirty[c] = false;
+        for (const Member& m : columns[c]) SetShooter(m.index, IsBottom(enemies, m.index));
+    }
+    anyDirty = false;
+}
+
+const std::vector<uint32_t>& ShooterIndex::Shooters(const EnemyArray& enemies) {
+    Refresh(enemies);
+    return shooters;
+}
+
+void ShooterIndex::Pick(const EnemyArray& enemies, int count, Rng& rng, std::vector<uint32_t>& out) {
+    const std::vector<uint32_t>& candidates = Shooters(enemies);
+    out.assign(candidates.begin(), candidates.end());
+    // Fisher-Yates parcial: los count primeros quedan elegidos al azar y sin repetir
+    const int n = (int)out.size();
+    const int k = std::min(count, n);
+    for (int s = 0; s < k; ++s) {
+        const int r = s + rng.Range(n - s);
+        std::swap(out[s], out[r]);
+    }
+    out.resize(k);
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Enemy.h"
+#include "Rng.h"
+
+// Índice de tiradores de la formación: los enemigos vivos de la "fila inferior", con la misma
+// regla que el antiguo FireRandomBullet O(N^2): un enemigo dispara si ningún otro vivo con
+// |dx| < Reach (por x) está más abajo. Más el primer boss con triple disparo pendiente.
+//
+// Se mantiene de forma incremental: los enemigos viven en cubos de Reach px por x, cada uno
+// ordenado por y (el más bajo primero), así que los que pueden tapar a un enemigo están en su
+// cubo y los dos vecinos. Quien cambia la formación avisa:
+//  - OnMove: EnemyManager::Update, una vez por enemigo con su posición final del paso
+//  - OnDeath / OnSpawn: CollisionManager (muertes por bala, choques, escapes, hijos de splitter)
+// Cada aviso recoloca al enemigo en su cubo y marca ese cubo y los vecinos como pendientes;
+// Pick recalcula sólo los pendientes (una muerte cuesta lo que tengan tres columnas) y elegir
+// tirador es O(1). LoadLevel y RestoreState usan Rebuild.
+class ShooterIndex {
+public:
+    static constexpr float Reach = 30.0f;
+    static constexpr int Columns = 27; // ceil(800 / 30); lo que se salga va al cubo del borde
+    static constexpr uint32_t None = 0xFFFFFFFFu;
+
+    void Rebuild(const EnemyArray& enemies);
+    void OnSpawn(const EnemyArray& enemies, uint32_t i);
+    void OnDeath(uint32_t i);
+    // Posición de i cambiada (o no: entonces no hace nada). También da de alta/baja a quien
+    // haya nacido o muerto sin aviso
+    void OnMove(const EnemyArray& enemies, uint32_t i);
+
+    // Boss con TripleShot pendiente (el de menor índice) o None. Update lo rehace cada paso
+    void BeginBosses() { tripleShotBoss = None; }
+    void NoteBoss(const EnemyArray& enemies, uint32_t i);
+    uint32_t TripleShotBoss() const { return tripleShotBoss; }
+
+    // Tiradores en orden de índice (el mismo orden que la antigua lista bottomEnemies)
+    const std::vector<uint32_t>& Shooters(const EnemyArray& enemies);
+
+    // Hasta count tiradores distintos al azar (una volea). Con count == 1 consume una sola
+    // tirada de rng sobre la lista en orden de índice, igual que el antiguo FireRandomBullet
+    void Pick(const EnemyArray& enemies, int count, Rng& rng, std::vector<uint32_t>& out);
+
+private:
+    struct Member { uint32_t index; float y; };
+    static constexpr int16_t kNoColumn = -1;
+
+    static int ColumnOf(float x);
+    void Insert(int col, uint32_t i, float y);
+    void Remove(int col, uint32_t i);
+    void MarkAround(int col);
+    bool IsBottom(const EnemyArray& enemies, uint32_t i) const;
+    void SetShooter(uint32_t i, bool on);
+    void Refresh(const EnemyArray& enemies);
+
+    // Por cubo: miembros ordenados por y descendente (el más bajo en pantalla primero)
+    std::vector<Member> columns[Columns];
+    bool dirty[Columns] = {};
+    bool anyDirty = false;
+    // Por enemigo: cubo y posición con la que está indexado, y si es tirador
+    std::vector<int16_t> columnOf;
+    std::vector<float> keyX, keyY;
+    std::vector<uint8_t> shooter;
+    std::vector<uint32_t> shooters; // ordenados por índice
+    uint32_t tripleShotBoss = None;
+};
@@ -0,0 +1,220 @@
+#include "SimulationRunner.h"
+#include "Game.h"
+#include "Log.h"
+#include <atomic>
+#include <thread>
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <filesystem>
+#include "../libs/nlohmann/json.hpp"
+using json = nlohmann::json;
+
+SimulationRunner::SimulationRunner(int threads) {
+    if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+    threadCount = threads > 0 ? threads : 1;
+}
+
+RunMetrics SimulationRunner::RunOne(const SimJob& job) {
+    GameConfig cfg;
+    cfg.autoplay = true;
+    cfg.headless = true;
+    cfg.seed = job.seed;
+    cfg.ai = job.ai;
+    cfg.maxSimSeconds = job.maxSimSeconds;
+    // Los ficheros de historial son compartidos: con varias partidas a la vez se pisarían
+    cfg.writeHistory = false;
+
+    Game game;
+    if (!game.Init(cfg)) {
+        LOG_ERROR(Game, "SimulationRunner: Init failed for seed " << job.seed);
+        RunMetrics m;
+        m.seed = (int)job.seed;
+        return m;
+    }
+    game.Run();
+    return game.GetRunMetrics();
+}
+
+std::vector<RunMetrics> SimulationRunner::Run(const std::vector<SimJob>& jobs) {
+    std::vector<RunMetrics> results(jobs.size());
+    if (jobs.empty()) return results;
+
+    // Cola de trabajo = índice atómico: cada worker toma el siguiente job libre, así las
+    // partidas largas no dejan hilos ociosos y no hace falta ningún mutex
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (;;) {
+            size_t i = next.fetch_add(1);
+            if (i >= jobs.size()) break;
+            results[i] = RunOne(jobs[i]);
+        }
+    };
+
+    int n = threadCount;
+    if ((size_t)n > jobs.size()) n = (int)jobs.size();
+    std::vector<std::thread> pool;
+    pool.reserve(n > 0 ? n - 1 : 0);
+    for (int t = 1; t < n; ++t) pool.emplace_back(worker);
+    worker(); // el hilo que llama también trabaja
+    for (auto& th : pool) th.join();
+    return results;
+}
+
+double TuningObjective(const RunMetrics& m) {
+    return m.durationSeconds + m.enemyHitsTaken * 8.0 + m.powerupPickupLatencyAvg * 0.5 - m.powerupsCollected * 6.0;
+}
+
+bool BatchOptions::FromArgs(int argc, char* argv[], BatchOptions& out) {
+    bool found = false;
+    for (int i = 1; i < argc; ++i) {
+        if (argv[i] == nullptr) continue;
+        std::string s(argv[i]);
+        bool hasValue = (i + 1 < argc && argv[i + 1] != nullptr);
+        if (s == "--batch-seeds" && hasValue) {
+            // "A-B" (inclusive) o una sola semilla "A"
+            std::string range(argv[++i]);
+            size_t dash = range.find('-');
+            try {
+                out.firstSeed = (unsigned int)std::stoul(range.substr(0, dash));
+                out.lastSeed = (dash == std::string::npos) ? out.firstSeed : (unsigned int)std::stoul(range.substr(dash + 1));
+            } catch (...) {
+                std::cerr << "[Batch] Invalid --batch-seeds value: " << range << std::endl;
+                out.valid = false;
+                return true;
+            }
+            if (out.lastSeed < out.firstSeed) std::swap(out.firstSeed, out.lastSeed);
+            found = true;
+        } else if (s == "--threads" && hasValue) {
+            out.threads = std::atoi(argv[++i]);
+        } else if (s == "--out" && hasValue) {
+            out.outPath = argv[++i];
+        } else if (s == "--max-sim-seconds" && hasValue) {
+            out.maxSimSeconds = std::atof(argv[++i]);
+        }
+    }
+    if (found) {
+        out.ai = AIParams::FromEnv();
+        if (out.outPath.empty()) out.outPath = "logs/batch_" + std::to_string(out.firstSeed) + "-" + std::to_string(out.lastSeed) + ".json";
+    }
+    return found;
+}
+
+// Estadísticos de una serie: media, desviación típica muestral (como statistics.stdev de
+// Python) y percentiles con interpolación lineal
+static json SummaryStats(std::vector<double> v) {
+    json j;
+    if (v.empty()) return j;
+    std::sort(v.begin(), v.end());
+    double sum = 0.0;
+    for (double x : v) sum += x;
+    const double mean = sum / (double)v.size();
+    double sq = 0.0;
+    for (double x : v) sq += (x - mean) * (x - mean);
+    auto percentile = [&](double p) {
+        double pos = p * (double)(v.size() - 1);
+        size_t lo = (size_t)pos;
+        size_t hi = std::min(lo + 1, v.size() - 1);
+        return v[lo] + (v[hi] - v[lo]) * (pos - (double)lo);
+    };
+    j["mean"] = mean;
+    j["stdev"] = v.size() > 1 ? std::sqrt(sq / (double)(v.size() - 1)) : 0.0;
+    j["min"] = v.front();
+    j["p10"] = percentile(0.10);
+    j["p25"] = percentile(0.25);
+    j["p50"] = percentile(0.50);
+    j["p75"] = percentile(0.75);
+    j["p90"] = percentile(0.90);
+    j["p95"] = percentile(0.95);
+    j["p99"] = percentile(0.99);
+    j["max"] = v.back();
+    return j;
+}
+
+int RunBatch(const BatchOptions& opt) {
+    if (!opt.valid) return 1;
+    std::vector<SimJob> jobs;
+    jobs.reserve(opt.lastSeed - opt.firstSeed + 1);
+    for (unsigned int seed = opt.firstSeed; ; ++seed) {
+        SimJob job;
+        job.seed = seed;
+        job.ai = opt.ai;
+        job.maxSimSeconds = opt.maxSimSeconds;
+        jobs.push_back(job);
+        if (seed == opt.lastSeed) break;
+    }
+
+    SimulationRunner runner(opt.threads);
+    std::cout << "[Batch] Running " << jobs.size() << " seeds (" << opt.firstSeed << "-" << opt.lastSeed
+              << ") on " << runner.GetThreadCount() << " threads" << std::endl;
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<RunMetrics> results = runner.Run(jobs);
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    // Que el log de las partidas no se mezcle con el resumen
+    Logger::Get().Flush();
+
+    std::vector<double> duration, score, hits, powerups, latency, objective;
+    int timeouts = 0;
+    json runs = json::array();
+    for (const auto& m : results) {
+        double obj = TuningObjective(m);
+        if (m.timedOut) timeouts++;
+        duration.push_back(m.durationSeconds);
+        score.push_back(m.score);
+        hits.push_back(m.enemyHitsTaken);
+        powerups.push_back(m.powerupsCollected);
+        latency.push_back(m.powerupPickupLatencyAvg);
+        objective.push_back(obj);
+
+        // Mismos campos que logs/run_<seed>.json, más el objetivo
+        json r;
+        r["seed"] = m.seed;
+        r["duration_seconds"] = m.durationSeconds;
+        r["max_level"] = m.maxLevel;
+        r["lives"] = m.lives;
+        r["score"] = m.score;
+        r["powerups_collected"] = m.powerupsCollected;
+        r["enemy_hits_taken"] = m.enemyHitsTaken;
+        r["shots_fired"] = m.shotsFired;
+        r["time_idle"] = m.timeIdle;
+        r["powerup_pickup_count"] = m.powerupPickupCount;
+        r["powerup_pickup_latency_avg"] = m.powerupPickupLatencyAvg;
+        r["objective"] = obj;
+        r["timed_out"] = m.timedOut;
+        runs.push_back(r);
+    }
+
+    json report;
+    report["seed_first"] = opt.firstSeed;
+    report["seed_last"] = opt.lastSeed;
+    report["count"] = results.size();
+    report["threads"] = runner.GetThreadCount();
+    report["wall_seconds"] = wall;
+    report["timeouts"] = timeouts;
+    report["params"] = { {"enemy_w", opt.ai.enemyW}, {"enemy_h", opt.ai.enemyH}, {"occlusion_penalty", opt.ai.occlusionPenalty} };
+    report["stats"] = {
+        {"duration_seconds", SummaryStats(duration)},
+        {"score", SummaryStats(score)},
+        {"enemy_hits_taken", SummaryStats(hits)},
+        {"powerups_collected", SummaryStats(powerups)},
+        {"powerup_pickup_latency_avg", SummaryStats(latency)},
+        {"objective", SummaryStats(objective)}
+    };
+    report["runs"] = runs;
+
+    std::filesystem::path outPath(opt.outPath);
+    std::error_code ec;
+    if (outPath.has_parent_path()) std::filesystem::create_directories(outPath.parent_path(), ec);
+    std::ofstream out(outPath.string());
+    if (!out.good()) {
+        std::cerr << "[Batch] Could not write report to " << opt.outPath << std::endl;
+        return 1;
+    }
+    out << report.dump(2);
+    out.close();
+    std::cout << "[Batch] " << results.size() << " runs in " << wall << "s, objective mean "
+              << report["stats"]["objective"]["mean"].get<double>() << " -> " << opt.outPath << std::endl;
+    return 0;
+}
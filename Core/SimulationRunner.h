@@ -0,0 +1,55 @@
+#pragma once
+#include "GameConfig.h"
+#include <vector>
+#include <string>
+
+// Ejecuta muchas partidas headless dentro del mismo proceso, repartidas entre un pool
+// de hilos. Cada partida es una instancia independiente de Game con su propia semilla
+// y parámetros de IA; no comparten estado global, así que el resultado de cada una es
+// idéntico al de lanzar `SpaceInvaders.exe --autoplay --headless --seed N`.
+struct SimJob {
+    unsigned int seed = 0;
+    AIParams ai;
+    // Límite de tiempo simulado por partida (0 = sin límite)
+    double maxSimSeconds = 0.0;
+};
+
+class SimulationRunner {
+public:
+    // threads <= 0 -> std::thread::hardware_concurrency()
+    explicit SimulationRunner(int threads = 0);
+
+    // Ejecuta todos los jobs y devuelve sus métricas en el mismo orden que la entrada
+    std::vector<RunMetrics> Run(const std::vector<SimJob>& jobs);
+
+    int GetThreadCount() const { return threadCount; }
+
+    // Ejecuta una sola partida en el hilo actual
+    static RunMetrics RunOne(const SimJob& job);
+
+private:
+    int threadCount = 1;
+};
+
+// Objetivo de tuning (menor es mejor). Mismo cálculo que compute_objective_from_log
+// en tools/tune_params_optuna.py
+double TuningObjective(const RunMetrics& m);
+
+// Modo batch del ejecutable: `--batch-seeds A-B [--threads N] [--out report.json]
+// [--max-sim-seconds S]`. Ejecuta todas las semillas headless+autoplay en este proceso
+// y escribe un único JSON con media, stdev y percentiles de cada métrica.
+struct BatchOptions {
+    unsigned int firstSeed = 0;
+    unsigned int lastSeed = 0;
+    int threads = 0; // 0 = todos los núcleos
+    std::string outPath; // vacío -> logs/batch_<A>-<B>.json
+    double maxSimSeconds = 600.0;
+    AIParams ai;
+    bool valid = true; // false si el rango de semillas no se pudo parsear
+
+    // Devuelve false si no hay --batch-seeds en la línea de comandos
+    static bool FromArgs(int argc, char* argv[], BatchOptions& out);
+};
+
+// Ejecuta el batch y escribe el informe. Devuelve el código de salida del proceso.
+int RunBatch(const BatchOptions& opt);
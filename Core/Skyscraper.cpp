@@ -1,9 +1,19 @@
 #include "Skyscraper.h"
+#include "Profiler.h"
 #include <SDL3/SDL.h>
-#include <SDL3_image/SDL_image.h>
-#include <iostream>
+#include "AssetCache.h"
+#include "Log.h"
+#include "BitOps.h"
 #include <cstring>
 #include <algorithm>
+#include <cmath>
+
+// Bits [lo, hi] (inclusive) de una palabra de la máscara
+static inline uint64_t SpanBits(int lo, int hi) {
+    uint64_t m = ~0ull << lo;
+    if (hi < 63) m &= ~(~0ull << (hi + 1));
+    return m;
+}
 
 // Helper to create a procedural surface matching given size
 static SDL_Surface* CreateProceduralSurface(int w, int h) {
@@ -33,7 +43,7 @@ static SDL_Surface* CreateProceduralSurface(int w, int h) {
 }
 
 // Helper: scale a surface to target size using nearest-neighbor sampling
-static SDL_Surface* ScaleSurfaceNearest(SDL_Surface* src, int dstW, int dstH) {
+static SDL_Surface* ScaleSurfaceNearest(const SDL_Surface* src, int dstW, int dstH) {
     if (!src) return nullptr;
     SDL_Surface* dst = SDL_CreateSurface(dstW, dstH, SDL_PIXELFORMAT_RGBA32);
     if (!dst) return nullptr;
@@ -69,33 +79,28 @@ static SDL_Surface* ScaleSurfaceNearest(SDL_Surface* src, int dstW, int dstH) {
 
 void Skyscraper::Initialize(SDL_Renderer* rend) {
     Destroy();
+    history.resize(kHistoryDepth);
     surfW = (int)originalRect.w;
     surfH = (int)originalRect.h;
 
     if (!imagePath.empty()) {
-        SDL_Surface* loaded = IMG_Load(imagePath.c_str());
-        if (loaded) {
-            // if size differs, scale by blit scaled fallback to create surface of correct size
-            if (loaded->w != surfW || loaded->h != surfH) {
-                SDL_Surface* scaled = SDL_CreateSurface(surfW, surfH, SDL_PIXELFORMAT_RGBA32);
-                if (scaled) {
-                    // Use nearest-neighbor scaler helper instead of SDL_BlitScaled to avoid API rename issues
-                    SDL_Surface* scaled2 = ScaleSurfaceNearest(loaded, surfW, surfH);
-                    SDL_DestroySurface(loaded);
-                    if (scaled2) {
-                        SDL_DestroySurface(scaled);
-                        surface = scaled2;
-                    } else {
-                        surface = scaled; // fallback
+        // Imagen decodificada una vez por proceso (AssetCache, RGBA32 y compartida): aquí
+        // sólo se copian sus píxeles a la surface propia, que es la que se borra
+        AssetCache::Image image = AssetCache::Get().AcquireImage(imagePath);
+        if (image) {
+            if (image->w != surfW || image->h != surfH) {
+                // Use nearest-neighbor scaler helper instead of SDL_BlitScaled to avoid API rename issues
+                surface = ScaleSurfaceNearest(image.get(), surfW, surfH);
+            } else {
+                surface = SDL_CreateSurface(surfW, surfH, SDL_PIXELFORMAT_RGBA32);
+                if (surface) {
+                    // Copia por filas (un blit escribiría en la imagen compartida)
+                    for (int y = 0; y < surfH; ++y) {
+                        memcpy((Uint8*)surface->pixels + y * surface->pitch,
+                               (const Uint8*)image->pixels + y * image->pitch, (size_t)surfW * 4);
                     }
-                } else {
-                    surface = loaded;
                 }
-            } else {
-                surface = loaded;
             }
-        } else {
-            std::cout << "[Skyscraper] IMG_Load failed for " << imagePath << " : " << SDL_GetError() << std::endl;
         }
     }
 
@@ -112,14 +117,17 @@ void Skyscraper::Initialize(SDL_Renderer* rend) {
                 surface = conv;
             }
         }
+        // Guardar la imagen intacta para reconstruir estados desde snapshots
+        pristine.resize((size_t)surfW * surfH);
+        for (int y = 0; y < surfH; ++y) {
+            memcpy(&pristine[(size_t)y * surfW], (Uint8*)surface->pixels + y * surface->pitch, (size_t)surfW * 4);
+        }
+        RebuildMask();
+        pristineMask = mask;
         // Create texture only if a renderer was provided. Allow Initialize(nullptr)
         // to prepare the mutable surface for collision checks without creating a texture.
         if (rend) {
-            texture = SDL_CreateTextureFromSurface(rend, surface);
-            if (texture) {
-                SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
-                SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
-            }
+            CreateTexture(rend);
         } else {
             texture = nullptr;
         }
@@ -127,42 +135,100 @@ void Skyscraper::Initialize(SDL_Renderer* rend) {
 }
 
 void Skyscraper::ApplyExplosion(int cx, int cy, int radius) {
+    ClearCircle(cx, cy, radius, nullptr);
+}
+
+void Skyscraper::ClearCircle(int cx, int cy, int radius, DamageRecord* undo) {
     if (!surface) return;
+    PROFILE_SCOPE("skyscraper.explosion");
     
-    std::cout << "[Skyscraper] ApplyExplosion at (" << cx << "," << cy << ") radius=" << radius << std::endl;
+    LOG_DEBUG(Skyscraper, "ApplyExplosion at (" << cx << "," << cy << ") radius=" << radius);
     
     Uint32* pixels = (Uint32*)surface->pixels;
     int pitch = surface->pitch / 4;
     int r2 = radius * radius;
     int y0 = std::max(0, cy - radius);
     int y1 = std::min(surfH - 1, cy + radius);
-    int x0 = std::max(0, cx - radius);
-    int x1 = std::min(surfW - 1, cx + radius);
+    MarkDirty(cx - radius, y0, cx + radius, y1);
     
+    // Por filas: el círculo corta cada fila en un tramo [cx-half, cx+half] que se apaga en la
+    // máscara palabra a palabra; el popcount de lo que estaba encendido es lo que se resta.
     int pixelsCleared = 0;
-    const SDL_PixelFormatDetails* d = SDL_GetPixelFormatDetails(surface->format);
+    int opaqueCleared = 0;
     for (int y = y0; y <= y1; ++y) {
         int dy = y - cy;
-        for (int x = x0; x <= x1; ++x) {
-            int dx = x - cx;
-            if (dx*dx + dy*dy <= r2) {
-                pixels[y * pitch + x] = SDL_MapRGBA(d, nullptr, 0,0,0,0);
-                pixelsCleared++;
+        int rem = r2 - dy * dy;
+        if (rem < 0) continue;
+        // Mayor half con half*half <= rem (mismo criterio que dx*dx + dy*dy <= r2)
+        int half = (int)std::sqrt((float)rem);
+        while (half * half > rem) --half;
+        while ((half + 1) * (half + 1) <= rem) ++half;
+        int xa = std::max(0, cx - half);
+        int xb = std::min(surfW - 1, cx + half);
+        if (xa > xb) continue;
+
+        uint64_t* row = &mask[(size_t)y * maskStride];
+        Uint32* prow = pixels + y * pitch;
+        for (int wi = xa >> 6; wi <= (xb >> 6); ++wi) {
+            int lo = std::max(xa - (wi << 6), 0);
+            int hi = std::min(xb - (wi << 6), 63);
+            uint64_t m = SpanBits(lo, hi);
+            opaqueCleared += PopCount64(row[wi] & m);
+            row[wi] &= ~m;
+            // La surface sólo se usa para dibujar: mismo tramo a transparente, apuntando
+            // para el history qué píxeles no estaban ya vacíos
+            uint64_t erased = 0;
+            for (int b = lo; b <= hi; ++b) {
+                Uint32& px = prow[(wi << 6) + b];
+                if (px != 0) { erased |= 1ull << b; px = 0; }
+            }
+            if (undo && erased) {
+                undo->word.push_back((uint32_t)((size_t)y * maskStride + wi));
+                undo->cleared.push_back(erased);
             }
         }
+        pixelsCleared += xb - xa + 1;
     }
+    opaqueCount -= opaqueCleared;
     
-    std::cout << "[Skyscraper] Cleared " << pixelsCleared << " pixels in explosion" << std::endl;
-    
-    // mark texture for update; texture will be recreated lazily when Render is called
-    if (texture) { SDL_DestroyTexture(texture); texture = nullptr; }
+    LOG_DEBUG(Skyscraper, "Cleared " << pixelsCleared << " pixels in explosion");
+}
+
+void Skyscraper::UndoDamage(const DamageRecord& rec) {
+    Uint32* pixels = (Uint32*)surface->pixels;
+    int pitch = surface->pitch / 4;
+    for (size_t k = 0; k < rec.word.size(); ++k) {
+        const uint32_t wi = rec.word[k];
+        const int y = (int)(wi / maskStride);
+        const int xBase = (int)(wi % maskStride) << 6;
+        Uint32* prow = pixels + y * pitch;
+        const Uint32* orig = &pristine[(size_t)y * surfW];
+        MarkDirty(xBase, y, xBase + 63, y);
+        for (uint64_t bits = rec.cleared[k]; bits; bits &= bits - 1) {
+            const int x = xBase + CountTrailingZeros64(bits);
+            prow[x] = orig[x];
+        }
+        const uint64_t restored = rec.cleared[k] & pristineMask[wi];
+        opaqueCount += PopCount64(restored & ~mask[wi]);
+        mask[wi] |= restored;
+    }
+}
+
+void Skyscraper::ClearHistory() {
+    for (DamageRecord& rec : history) {
+        rec.word.clear();
+        rec.cleared.clear();
+    }
+    historyHead = 0;
+    historyCount = 0;
 }
 
 void Skyscraper::TakeBulletHit(float wx, float wy, int radius) {
     if (!surface) return;
+    PROFILE_SCOPE("skyscraper.bulletHit");
     
     // Log the hit for debugging
-    std::cout << "[Skyscraper] TakeBulletHit at world coords (" << wx << "," << wy << ") radius=" << radius << std::endl;
+    LOG_DEBUG(Skyscraper, "TakeBulletHit at world coords (" << wx << "," << wy << ") radius=" << radius);
     
     // Convert world coords to local surface coords
     float lx = (wx - rect.x) * (surfW / rect.w);
@@ -170,104 +236,51 @@ void Skyscraper::TakeBulletHit(float wx, float wy, int radius) {
     int cx = (int)lx;
     int cy = (int)ly;
     
-    std::cout << "[Skyscraper] Local surface coords: (" << cx << "," << cy << ") surface size: " << surfW << "x" << surfH << std::endl;
+    LOG_DEBUG(Skyscraper, "Local surface coords: (" << cx << "," << cy << ") surface size: " << surfW << "x" << surfH);
     
-    // Save snapshot of current surface to history (undo point) before applying damage
-    if ((int)history.size() >= 8) {
-        // limit history depth to 8: free oldest
-        SDL_DestroySurface(history.front());
-        history.erase(history.begin());
-    }
-    // Create a copy of the surface
-    SDL_Surface* snap = SDL_CreateSurface(surface->w, surface->h, SDL_PIXELFORMAT_RGBA32);
-    if (snap) {
-        // copy pixels
-        int bytes = surface->pitch * surface->h;
-        memcpy(snap->pixels, surface->pixels, bytes);
-        history.push_back(snap);
-    }
+    // Undo point: the explosion records the pixels it clears into the next ring slot,
+    // overwriting the oldest impact once the ring is full
+    DamageRecord& rec = history[historyHead];
+    rec.word.clear();
+    rec.cleared.clear();
+    historyHead = (historyHead + 1) % kHistoryDepth;
+    if (historyCount < kHistoryDepth) historyCount++;
 
-    ApplyExplosion(cx, cy, radius);
+    ClearCircle(cx, cy, radius, &rec);
     // store last impact (world coords) for debug visualization
     lastImpactX = wx;
     lastImpactY = wy;
     
-    // After modifying surface, destroy texture so it will be recreated with new pixels
-    if (texture) { SDL_DestroyTexture(texture); texture = nullptr; }
-    
     // Update alive flag: if most pixels are transparent, mark dead.
-    Uint32* pixels = (Uint32*)surface->pixels;
-    int pitch = surface->pitch / 4;
     int total = surfW * surfH;
-    int opaque = 0;
-    for (int i = 0; i < total; ++i) {
-        Uint32 p = pixels[i];
-        Uint8 r,g,b,a;
-        SDL_GetRGBA(p, SDL_GetPixelFormatDetails(surface->format), nullptr, &r, &g, &b, &a);
-        if (a > 16) opaque++;
-    }
+    LOG_DEBUG(Skyscraper, "After explosion: " << opaqueCount << "/" << total << " opaque pixels (" << (100.0f * opaqueCount / total) << "%)");
     
-    std::cout << "[Skyscraper] After explosion: " << opaque << "/" << total << " opaque pixels (" << (100.0f * opaque / total) << "%)" << std::endl;
-    
-    if (opaque < total/20) { // less than 5% opaque
-        alive = false;
-        std::cout << "[Skyscraper] Building destroyed!" << std::endl;
-    }
+    UpdateAliveFromMask();
+    if (!alive) LOG_INFO(Skyscraper, "Building destroyed!");
 }
 
 void Skyscraper::RestoreFromHistory(int levels, SDL_Renderer* rend) {
     if (levels <= 0) return;
-    if (history.empty()) return;
+    if (historyCount == 0 || !surface) return;
     // If building is dead, do not resurrect via history
     if (!alive) return;
 
-    int take = std::min((int)history.size(), levels);
-    // pick the snapshot 'take' steps back from the end
-    SDL_Surface* target = history[history.size() - take];
-    if (!target) return;
-
-    // Replace current surface with a copy of target
-    SDL_Surface* newSurf = SDL_CreateSurface(target->w, target->h, SDL_PIXELFORMAT_RGBA32);
-    if (!newSurf) return;
-    int bytes = target->pitch * target->h;
-    memcpy(newSurf->pixels, target->pixels, bytes);
-
-    // swap surfaces
-    if (surface) SDL_DestroySurface(surface);
-    surface = newSurf;
-
-    // Update texture immediately if renderer provided
-    if (rend) {
-        if (texture) SDL_DestroyTexture(texture);
-        texture = SDL_CreateTextureFromSurface(rend, surface);
-        if (texture) {
-            SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
-            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
-        }
-    }
-
-    // Trim history: remove the last 'take' entries
+    // Undo the last 'take' impacts, newest first
+    int take = std::min(historyCount, levels);
     for (int i = 0; i < take; ++i) {
-        SDL_DestroySurface(history.back());
-        history.pop_back();
+        historyHead = (historyHead + kHistoryDepth - 1) % kHistoryDepth;
+        UndoDamage(history[historyHead]);
+        history[historyHead].word.clear();
+        history[historyHead].cleared.clear();
+        historyCount--;
     }
 
+    // Update texture immediately if renderer provided (otherwise on next Render)
+    if (rend) UpdateTexture(rend);
+
     // Recompute alive flag conservatively
-    Uint32* pixels = (Uint32*)surface->pixels;
-    int pitch = surface->pitch / 4;
-    int total = surfW * surfH;
-    int opaque = 0;
-    for (int i = 0; i < total; ++i) {
-        Uint32 p = pixels[i];
-        Uint8 r,g,b,a;
-        SDL_GetRGBA(p, SDL_GetPixelFormatDetails(surface->format), nullptr, &r, &g, &b, &a);
-        if (a > 16) opaque++;
-    }
-    if (opaque < total/20) {
-        alive = false;
-    } else {
-        alive = true;
-    }
+    alive = true;
+    UpdateAliveFromMask();
 }
 
 bool Skyscraper::IsOpaqueAtWorld(float wx, float wy, Uint8 alphaThreshold) const {
@@ -278,6 +291,10 @@ bool Skyscraper::IsOpaqueAtWorld(float wx, float wy, Uint8 alphaThreshold) const
     int x = (int)lx;
     int y = (int)ly;
     if (x < 0 || y < 0 || x >= surfW || y >= surfH) return false;
+    if (alphaThreshold == kOpaqueAlpha) {
+        return (mask[(size_t)y * maskStride + (x >> 6)] >> (x & 63)) & 1u;
+    }
+    // Otro umbral: leer el alpha de la surface
     const Uint32* pixels = (const Uint32*)surface->pixels;
     int pitch = surface->pitch / 4;
     Uint32 p = pixels[y * pitch + x];
@@ -286,34 +303,165 @@ bool Skyscraper::IsOpaqueAtWorld(float wx, float wy, Uint8 alphaThreshold) const
     return a > alphaThreshold;
 }
 
+void Skyscraper::RebuildMask() {
+    maskStride = (surfW + 63) / 64;
+    mask.assign((size_t)maskStride * surfH, 0);
+    opaqueCount = 0;
+    if (!surface) return;
+    const SDL_PixelFormatDetails* d = SDL_GetPixelFormatDetails(surface->format);
+    for (int y = 0; y < surfH; ++y) {
+        const Uint32* pixels = (const Uint32*)((const Uint8*)surface->pixels + y * surface->pitch);
+        uint64_t* row = &mask[(size_t)y * maskStride];
+        for (int x = 0; x < surfW; ++x) {
+            Uint8 r,g,b,a;
+            SDL_GetRGBA(pixels[x], d, nullptr, &r, &g, &b, &a);
+            if (a > kOpaqueAlpha) row[x >> 6] |= 1ull << (x & 63);
+        }
+        for (int wi = 0; wi < maskStride; ++wi) opaqueCount += PopCount64(row[wi]);
+    }
+}
+
+void Skyscraper::UpdateAliveFromMask() {
+    if (opaqueCount < (surfW * surfH) / 20) alive = false; // less than 5% opaque
+}
+
 void Skyscraper::Restore(SDL_Renderer* rend) {
     Initialize(rend);
 }
 
+void Skyscraper::MarkDirty(int x0, int y0, int x1, int y1) {
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, surfW - 1);
+    y1 = std::min(y1, surfH - 1);
+    if (x0 > x1 || y0 > y1) return;
+    if (dirty.w > 0) {
+        x0 = std::min(x0, dirty.x);
+        y0 = std::min(y0, dirty.y);
+        x1 = std::max(x1, dirty.x + dirty.w - 1);
+        y1 = std::max(y1, dirty.y + dirty.h - 1);
+    }
+    dirty = { x0, y0, x1 - x0 + 1, y1 - y0 + 1 };
+}
+
+bool Skyscraper::CreateTexture(SDL_Renderer* rend) {
+    if (texture) { SDL_DestroyTexture(texture); texture = nullptr; }
+    texture = SDL_CreateTexture(rend, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STREAMING, surfW, surfH);
+    if (!texture) {
+        LOG_WARN(Skyscraper, "SDL_CreateTexture failed: " << SDL_GetError());
+        return false;
+    }
+    SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    // Primera subida completa
+    dirty = { 0, 0, surfW, surfH };
+    return true;
+}
+
 void Skyscraper::UpdateTexture(SDL_Renderer* rend) {
     if (!surface) return;
-    if (texture) SDL_DestroyTexture(texture);
-    texture = SDL_CreateTextureFromSurface(rend, surface);
-    if (texture) {
-        SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
-        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
-    }
+    if (!texture && (!rend || !CreateTexture(rend))) return;
+    if (dirty.w <= 0) return;
+    PROFILE_SCOPE("skyscraper.upload");
+    const Uint8* src = (const Uint8*)surface->pixels + dirty.y * surface->pitch + dirty.x * 4;
+    SDL_UpdateTexture(texture, &dirty, src, surface->pitch);
+    dirty = { 0, 0, 0, 0 };
 }
 
 void Skyscraper::Render(SDL_Renderer* rend) {
     if (!alive) return;
-    if (!texture) UpdateTexture(rend);
+    UpdateTexture(rend);
     if (!texture) return;
     SDL_FRect dst = rect;
     SDL_RenderTexture(rend, texture, nullptr, &dst);
 }
 
+// Máscara de 1 bit por píxel (1 = píxel no borrado), filas consecutivas, LSB primero
+static void WriteMask(StateWriter& w, const SDL_Surface* s, int surfW, int surfH) {
+    const size_t nbits = (size_t)surfW * surfH;
+    uint8_t* bits = w.Append((nbits + 7) / 8);
+    memset(bits, 0, (nbits + 7) / 8);
+    size_t i = 0;
+    for (int y = 0; y < surfH; ++y) {
+        const Uint32* row = (const Uint32*)((const Uint8*)s->pixels + y * s->pitch);
+        for (int x = 0; x < surfW; ++x, ++i) {
+            if (row[x] != 0) bits[i >> 3] |= (uint8_t)(1u << (i & 7));
+        }
+    }
+}
+
+static bool ReadMask(StateReader& r, SDL_Surface* s, const std::vector<Uint32>& pristine, int surfW, int surfH) {
+    const size_t nbits = (size_t)surfW * surfH;
+    const uint8_t* bits = r.Take((nbits + 7) / 8);
+    if (!bits) return false;
+    size_t i = 0;
+    for (int y = 0; y < surfH; ++y) {
+        Uint32* row = (Uint32*)((Uint8*)s->pixels + y * s->pitch);
+        for (int x = 0; x < surfW; ++x, ++i) {
+            row[x] = (bits[i >> 3] >> (i & 7)) & 1u ? pristine[i] : 0u;
+        }
+    }
+    return true;
+}
+
+void Skyscraper::SaveState(StateWriter& w) const {
+    w.Put(rect); w.Put(originalRect);
+    w.Put(alive); w.Put(lastImpactX); w.Put(lastImpactY);
+    w.Put(surfW); w.Put(surfH);
+    bool hasSurface = (surface != nullptr && pristine.size() == (size_t)surfW * surfH);
+    w.Put(hasSurface);
+    if (!hasSurface) return;
+    WriteMask(w, surface, surfW, surfH);
+    // Impactos del history, del más antiguo al más reciente
+    w.Put<uint32_t>((uint32_t)historyCount);
+    for (int k = 0; k < historyCount; ++k) {
+        const DamageRecord& rec = history[(historyHead - historyCount + k + kHistoryDepth) % kHistoryDepth];
+        w.PutVector(rec.word);
+        w.PutVector(rec.cleared);
+    }
+}
+
+bool Skyscraper::RestoreState(StateReader& r) {
+    int w = 0, h = 0;
+    bool hasSurface = false;
+    r.Get(rect); r.Get(originalRect);
+    r.Get(alive); r.Get(lastImpactX); r.Get(lastImpactY);
+    r.Get(w); r.Get(h);
+    r.Get(hasSurface);
+    if (!r.Ok()) return false;
+    if (!hasSurface) return true;
+
+    // Asegurar que tenemos la imagen original del tamaño correcto (Initialize la recarga)
+    if (!surface || w != surfW || h != surfH || pristine.size() != (size_t)w * h) {
+        Initialize(nullptr);
+        if (!surface || w != surfW || h != surfH) return false;
+    }
+    if (!ReadMask(r, surface, pristine, surfW, surfH)) return false;
+
+    RebuildMask();
+
+    ClearHistory();
+    uint32_t n = 0;
+    if (!r.Get(n) || n > (uint32_t)kHistoryDepth) return false;
+    for (uint32_t k = 0; k < n; ++k) {
+        DamageRecord& rec = history[historyHead];
+        historyHead = (historyHead + 1) % kHistoryDepth;
+        historyCount++;
+        if (!r.GetVector(rec.word) || !r.GetVector(rec.cleared)) return false;
+        if (rec.word.size() != rec.cleared.size()) return false;
+        for (uint32_t wi : rec.word) if (wi >= mask.size()) return false;
+    }
+
+    // La surface entera ha cambiado: se sube completa en el siguiente Render
+    dirty = { 0, 0, surfW, surfH };
+    return true;
+}
+
 void Skyscraper::Destroy() {
     if (texture) { SDL_DestroyTexture(texture); texture = nullptr; }
     if (surface) { SDL_DestroySurface(surface); surface = nullptr; }
-    // free history
-    for (SDL_Surface* s : history) {
-        if (s) SDL_DestroySurface(s);
-    }
-    history.clear();
+    dirty = { 0, 0, 0, 0 };
+    ClearHistory();
+    mask.clear();
+    opaqueCount = 0;
 }
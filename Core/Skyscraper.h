@@ -2,6 +2,8 @@
 #include <SDL3/SDL.h>
 #include <string>
 #include <vector>
+#include <cstdint>
+#include "GameState.h"
 
 // Skyscraper: representa un edificio destructible por impactos
 // Implementa una superficie mutable con máscara alpha donde se borran píxeles
@@ -13,9 +15,13 @@ struct Skyscraper {
     // imagePath opcional: si se proporciona, se carga la imagen de textura (relative path)
     std::string imagePath;
 
-    // Surface y texture usadas internamente (surface mutable, texture para render)
+    // Surface y texture usadas internamente (surface mutable, texture para render).
+    // La texture es de streaming y vive lo mismo que la surface: los impactos amplían el
+    // rectángulo sucio y Render sube sólo esa zona una vez por frame (varios impactos en el
+    // mismo frame = una única subida).
     SDL_Surface* surface = nullptr;
     SDL_Texture* texture = nullptr;
+    SDL_Rect dirty = { 0, 0, 0, 0 }; // en px de la surface; w == 0 si no hay nada pendiente
 
     // altura/anchura en px de la surface interna
     int surfW = 0;
@@ -24,9 +30,31 @@ struct Skyscraper {
     float lastImpactX = -1.0f;
     float lastImpactY = -1.0f;
 
-    // History of surface states (snapshots) to allow rollback when RestoreDefense powerup is used
-    // Each entry is a full SDL_Surface* copy of the surface BEFORE an impact was applied.
-    std::vector<SDL_Surface*> history;
+    // History of impacts to allow rollback when RestoreDefense powerup is used.
+    // Cada impacto guarda sólo las palabras de la máscara que tocó y qué píxeles borró en
+    // ellas (bits de píxeles no vacíos antes del impacto): deshacer es volver a copiar esos
+    // píxeles desde pristine. Ring de kHistoryDepth impactos; el más antiguo se pisa.
+    struct DamageRecord {
+        std::vector<uint32_t> word;    // índice en mask
+        std::vector<uint64_t> cleared; // píxeles borrados en esa palabra
+    };
+    static constexpr int kHistoryDepth = 32;
+    std::vector<DamageRecord> history; // kHistoryDepth huecos, reservados en Initialize
+    int historyHead = 0;  // hueco del próximo impacto
+    int historyCount = 0; // impactos que se pueden deshacer
+
+    // Píxeles originales (RGBA32, surfW*surfH) capturados en Initialize. Los impactos sólo
+    // ponen píxeles a 0, así que cualquier estado es pristine & máscara: es lo que guarda el snapshot.
+    std::vector<Uint32> pristine;
+
+    // Máscara de opacidad de 1 bit por píxel (alpha > kOpaqueAlpha), maskStride palabras de
+    // 64 bits por fila. Colisiones y daño trabajan sólo con ella: la surface RGBA queda para
+    // dibujar. opaqueCount se mantiene al borrar (popcount de los bits que se apagan).
+    static constexpr Uint8 kOpaqueAlpha = 16;
+    std::vector<uint64_t> mask;
+    std::vector<uint64_t> pristineMask; // máscara de la imagen intacta
+    int maskStride = 0;
+    int opaqueCount = 0;
 
     Skyscraper(float x=0, float y=0, float w=60, float h=140, const std::string& img="") {
         rect = { x, y, w, h };
@@ -51,19 +79,37 @@ struct Skyscraper {
     // Restore the building to full health (recreate surface from image or procedural)
     void Restore(SDL_Renderer* rend);
 
-    // Restore previous surface state from history by 'levels' steps (1 = undo last impact).
+    // Undo the last 'levels' impacts from history (1 = undo last impact).
     // Only works if the skyscraper is still alive; will not resurrect fully destroyed buildings.
     void RestoreFromHistory(int levels, SDL_Renderer* rend);
 
-    // Recreate texture from surface (call after modifying surface)
+    // Upload the pending dirty region to the texture (creating it if needed)
     void UpdateTexture(SDL_Renderer* rend);
 
     // Render
     void Render(SDL_Renderer* rend);
 
     // Query: returns true if the surface at world coordinates (wx,wy) is opaque (> alphaThreshold)
-    bool IsOpaqueAtWorld(float wx, float wy, Uint8 alphaThreshold = 16) const;
+    bool IsOpaqueAtWorld(float wx, float wy, Uint8 alphaThreshold = kOpaqueAlpha) const;
+
+    // Snapshot (Game::SaveState): máscara de 1 bit por píxel de la surface y los impactos del
+    // history, sin punteros SDL. RestoreState reconstruye la surface a partir de pristine.
+    void SaveState(StateWriter& w) const;
+    bool RestoreState(StateReader& r);
 
     // Destroy resources
     void Destroy();
+
+private:
+    // Recalcular mask/opaqueCount desde la surface (Initialize, history, snapshot)
+    void RebuildMask();
+    // alive = false si queda menos de un 5% de píxeles opacos
+    void UpdateAliveFromMask();
+    // Explosión que, si undo no es nulo, apunta ahí los píxeles que borra
+    void ClearCircle(int cx, int cy, int radius, DamageRecord* undo);
+    void UndoDamage(const DamageRecord& rec);
+    void ClearHistory();
+    // Ampliar el rectángulo sucio con [x0,x1]x[y0,y1] (inclusive, px de la surface)
+    void MarkDirty(int x0, int y0, int x1, int y1);
+    bool CreateTexture(SDL_Renderer* rend);
 };
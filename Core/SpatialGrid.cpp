@@ -0,0 +1,63 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(float width, float height, float cellSize)
+    : cellSize(cellSize), invCell(1.0f / cellSize) {
+    cols = std::max(1, (int)std::ceil(width / cellSize));
+    rows = std::max(1, (int)std::ceil(height / cellSize));
+    cellStart.assign((size_t)cols * rows + 1, 0);
+}
+
+void SpatialGrid::CellRange(float x0, float y0, float x1, float y1, int& cx0, int& cy0, int& cx1, int& cy1) const {
+    // floor + clamp al borde: lo que sale del área cuenta como de la celda del borde
+    cx0 = std::clamp((int)std::floor(x0 * invCell), 0, cols - 1);
+    cy0 = std::clamp((int)std::floor(y0 * invCell), 0, rows - 1);
+    cx1 = std::clamp((int)std::floor(x1 * invCell), 0, cols - 1);
+    cy1 = std::clamp((int)std::floor(y1 * invCell), 0, rows - 1);
+}
+
+void SpatialGrid::Build(const float* x, const float* y, const float* w, const float* h, const uint8_t* alive, size_t n) {
+    std::fill(cellStart.begin(), cellStart.end(), 0u);
+
+    // 1) Cuántos objetos caen en cada celda (cellStart[c + 1] hace de contador)
+    size_t total = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (!alive[i]) continue;
+        int cx0, cy0, cx1, cy1;
+        CellRange(x[i], y[i], x[i] + w[i], y[i] + h[i], cx0, cy0, cx1, cy1);
+        for (int cy = cy0; cy <= cy1; ++cy)
+            for (int cx = cx0; cx <= cx1; ++cx) ++cellStart[(size_t)cy * cols + cx + 1];
+        total += (size_t)(cx1 - cx0 + 1) * (cy1 - cy0 + 1);
+    }
+    // 2) Suma prefija: inicio de cada celda
+    for (size_t c = 1; c < cellStart.size(); ++c) cellStart[c] += cellStart[c - 1];
+    // 3) Colocar (en orden de índice dentro de cada celda); cursor = copia de los inicios
+    items.resize(total);
+    cursor.assign(cellStart.begin(), cellStart.end() - 1);
+    for (size_t i = 0; i < n; ++i) {
+        if (!alive[i]) continue;
+        int cx0, cy0, cx1, cy1;
+        CellRange(x[i], y[i], x[i] + w[i], y[i] + h[i], cx0, cy0, cx1, cy1);
+        for (int cy = cy0; cy <= cy1; ++cy)
+            for (int cx = cx0; cx <= cx1; ++cx) items[cursor[(size_t)cy * cols + cx]++] = (uint32_t)i;
+    }
+}
+
+void SpatialGrid::Query(const SDL_FRect& r, std::vector<uint32_t>& out) const {
+    out.clear();
+    int cx0, cy0, cx1, cy1;
+    CellRange(r.x, r.y, r.x + r.w, r.y + r.h, cx0, cy0, cx1, cy1);
+    for (int cy = cy0; cy <= cy1; ++cy) {
+        for (int cx = cx0; cx <= cx1; ++cx) {
+            const size_t c = (size_t)cy * cols + cx;
+            out.insert(out.end(), items.begin() + cellStart[c], items.begin() + cellStart[c + 1]);
+        }
+    }
+    // Una sola celda ya viene ordenada y sin repetir; con varias, un objeto que toca más de
+    // una sale una vez por celda: ordenar y quitar duplicados
+    if (cx0 != cx1 || cy0 != cy1) {
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+}
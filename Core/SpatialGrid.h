@@ -0,0 +1,36 @@
+#pragma once
+#include <SDL3/SDL_rect.h>
+#include <cstdint>
+#include <vector>
+
+// Rejilla uniforme sobre el área de juego (800x600) para la fase ancha de colisiones.
+// Build reparte los objetos vivos por las celdas que toca su rect (ordenación por cuentas:
+// dos arrays planos, sin listas enlazadas ni reservas una vez calentada); Query devuelve
+// los candidatos de las celdas que toca un rect. Lo que cae fuera del área se asigna a las
+// celdas del borde, así que la consulta nunca pierde un solape.
+//
+// Los candidatos salen ordenados por índice y sin repetir: quien recorra Query en lugar de
+// todos los objetos ve los mismos impactos en el mismo orden (el primero que toca gana).
+// Query no modifica la rejilla (el buffer de salida es del llamador): entre dos Build se
+// puede consultar desde varios hilos a la vez, cada uno con su buffer.
+class SpatialGrid {
+public:
+    explicit SpatialGrid(float width = 800.0f, float height = 600.0f, float cellSize = 64.0f);
+
+    // Rehacer la rejilla con los n objetos (índices 0..n-1) que tengan alive[i] != 0
+    void Build(const float* x, const float* y, const float* w, const float* h, const uint8_t* alive, size_t n);
+    // Índices cuyo rect puede solapar r, ascendentes y sin duplicados (out se vacía antes)
+    void Query(const SDL_FRect& r, std::vector<uint32_t>& out) const;
+
+private:
+    void CellRange(float x0, float y0, float x1, float y1, int& cx0, int& cy0, int& cx1, int& cy1) const;
+
+    float cellSize;
+    float invCell;
+    int cols;
+    int rows;
+    // Celda c: items[cellStart[c] .. cellStart[c + 1])
+    std::vector<uint32_t> cellStart;
+    std::vector<uint32_t> items;
+    std::vector<uint32_t> cursor; // huecos de escritura por celda durante Build
+};
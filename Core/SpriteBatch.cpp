@@ -0,0 +1,107 @@
+#include "SpriteBatch.h"
+
+SpriteBatch::Group& SpriteBatch::GroupFor(SDL_Texture* texture) {
+    // Pocos grupos por frame (2-3): búsqueda lineal
+    for (size_t k = 0; k < used; ++k) {
+        if (groups[k].texture == texture) return groups[k];
+    }
+    if (used == groups.size()) groups.emplace_back();
+    Group& g = groups[used++];
+    g.texture = texture;
+    g.vertices.clear();
+    g.invW = g.invH = 1.0f;
+    float tw = 0.0f, th = 0.0f;
+    if (texture && SDL_GetTextureSize(texture, &tw, &th) && tw > 0.0f && th > 0.0f) {
+        g.invW = 1.0f / tw;
+        g.invH = 1.0f / th;
+    }
+    return g;
+}
+
+void SpriteBatch::PushQuad(Group& g, const SDL_FRect& dst, float u0, float v0, float u1, float v1, SDL_FColor color) {
+    const float x1 = dst.x + dst.w, y1 = dst.y + dst.h;
+    g.vertices.push_back({ { dst.x, dst.y }, color, { u0, v0 } });
+    g.vertices.push_back({ { x1, dst.y }, color, { u1, v0 } });
+    g.vertices.push_back({ { dst.x, y1 }, color, { u0, v1 } });
+    g.vertices.push_back({ { x1, y1 }, color, { u1, v1 } });
+}
+
+void SpriteBatch::Draw(SDL_Texture* texture, const SDL_FRect* src, const SDL_FRect& dst) {
+    Draw(texture, src, dst, SDL_Color{ 255, 255, 255, 255 });
+}
+
+void SpriteBatch::Draw(SDL_Texture* texture, const SDL_FRect* src, const SDL_FRect& dst, SDL_Color tint) {
+    if (!texture) return;
+    Group& g = GroupFor(texture);
+    float u0 = 0.0f, v0 = 0.0f, u1 = 1.0f, v1 = 1.0f;
+    if (src) {
+        u0 = src->x * g.invW;
+        v0 = src->y * g.invH;
+        u1 = (src->x + src->w) * g.invW;
+        v1 = (src->y + src->h) * g.invH;
+    }
+    PushQuad(g, dst, u0, v0, u1, v1, SDL_FColor{ tint.r / 255.0f, tint.g / 255.0f, tint.b / 255.0f, tint.a / 255.0f });
+}
+
+void SpriteBatch::FillRect(const SDL_FRect& r, SDL_FColor color) {
+    PushQuad(GroupFor(nullptr), r, 0.0f, 0.0f, 0.0f, 0.0f, color);
+}
+
+void SpriteBatch::FillRect(const SDL_FRect& r, SDL_Color color) {
+    FillRect(r, SDL_FColor{ color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f });
+}
+
+void SpriteBatch::OutlineRect(const SDL_FRect& r, SDL_Color color) {
+    if (r.w <= 0.0f || r.h <= 0.0f) return;
+    // Arriba y abajo a todo lo ancho; los lados sin repetir las esquinas
+    FillRect(SDL_FRect{ r.x, r.y, r.w, 1.0f }, color);
+    if (r.h > 1.0f) FillRect(SDL_FRect{ r.x, r.y + r.h - 1.0f, r.w, 1.0f }, color);
+    if (r.h > 2.0f) {
+        FillRect(SDL_FRect{ r.x, r.y + 1.0f, 1.0f, r.h - 2.0f }, color);
+        if (r.w > 1.0f) FillRect(SDL_FRect{ r.x + r.w - 1.0f, r.y + 1.0f, 1.0f, r.h - 2.0f }, color);
+    }
+}
+
+void SpriteBatch::FillCircle(int cx, int cy, int radius, SDL_Color color) {
+    if (radius < 0) return;
+    std::vector<SDL_FRect>& spans = circleSpans[radius];
+    if (spans.empty()) {
+        // Fila h: el mayor w con w² + h² <= radius² (en enteros, sin sqrt)
+        const int r2 = radius * radius;
+        int w = radius;
+        for (int h = 0; h <= radius; ++h) {
+            while (w * w + h * h > r2) --w;
+            spans.push_back({ (float)-w, (float)h, (float)(2 * w + 1), 1.0f });
+            if (h > 0) spans.push_back({ (float)-w, (float)-h, (float)(2 * w + 1), 1.0f });
+        }
+    }
+    for (const SDL_FRect& s : spans) {
+        FillRect(SDL_FRect{ s.x + (float)cx, s.y + (float)cy, s.w, s.h }, color);
+    }
+}
+
+size_t SpriteBatch::PendingQuads() const {
+    size_t n = 0;
+    for (size_t k = 0; k < used; ++k) n += groups[k].vertices.size() / 4;
+    return n;
+}
+
+void SpriteBatch::Flush(SDL_Renderer* renderer) {
+    lastDrawCalls = 0;
+    for (size_t k = 0; k < used; ++k) {
+        Group& g = groups[k];
+        const size_t quads = g.vertices.size() / 4;
+        if (renderer && quads > 0) {
+            // La tabla de índices sólo crece; es la misma para cualquier grupo
+            for (size_t q = indices.size() / 6; q < quads; ++q) {
+                const int v = (int)(q * 4);
+                indices.insert(indices.end(), { v, v + 1, v + 2, v + 2, v + 1, v + 3 });
+            }
+            SDL_RenderGeometry(renderer, g.texture, g.vertices.data(), (int)g.vertices.size(), indices.data(), (int)(quads * 6));
+            ++lastDrawCalls;
+        }
+        g.vertices.clear();
+        g.texture = nullptr;
+    }
+    used = 0;
+}
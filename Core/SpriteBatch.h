@@ -0,0 +1,57 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <unordered_map>
+#include <vector>
+
+// Lote de quads para el render de entidades: en lugar de una SDL_RenderTexture o
+// SDL_SetRenderDrawColor + SDL_RenderFillRect por sprite, los quads se agrupan por textura
+// (hoja de naves, hoja misc, color sólido = sin textura) y Flush los manda con una
+// SDL_RenderGeometry por grupo. El color va en cada vértice, así que mezclar colores no
+// corta el lote.
+//
+// Orden: dentro de una textura se respeta el orden de llegada; los grupos se dibujan en el
+// orden en que apareció su textura desde el último Flush. Si una capa tiene que quedar
+// encima de otra con distinta textura, hay que hacer Flush entre ambas.
+// Los buffers se reutilizan entre frames (sin reservas en régimen estable).
+class SpriteBatch {
+public:
+    // src en píxeles de la textura (nullptr = textura entera)
+    void Draw(SDL_Texture* texture, const SDL_FRect* src, const SDL_FRect& dst);
+    // Igual, multiplicando la textura por tint (glifos blancos del atlas de texto)
+    void Draw(SDL_Texture* texture, const SDL_FRect* src, const SDL_FRect& dst, SDL_Color tint);
+    // Rectángulo relleno (equivale a SDL_RenderFillRect)
+    void FillRect(const SDL_FRect& r, SDL_FColor color);
+    void FillRect(const SDL_FRect& r, SDL_Color color);
+    // Marco de 1 px por dentro de r (equivale a SDL_RenderRect)
+    void OutlineRect(const SDL_FRect& r, SDL_Color color);
+    // Círculo relleno: los mismos píxeles que x² + y² <= radius² punto a punto, como una
+    // franja horizontal por fila (2 * radius + 1 quads que no se solapan, así el alfa se
+    // mezcla igual que con SDL_RenderPoint). Las franjas se calculan una vez por radio.
+    void FillCircle(int cx, int cy, int radius, SDL_Color color);
+
+    // Dibuja lo acumulado y vacía el lote. renderer nulo: sólo vacía
+    void Flush(SDL_Renderer* renderer);
+
+    size_t PendingQuads() const;
+    // Llamadas a SDL_RenderGeometry del último Flush
+    int LastDrawCalls() const { return lastDrawCalls; }
+
+private:
+    struct Group {
+        SDL_Texture* texture = nullptr;
+        float invW = 1.0f, invH = 1.0f; // 1 / tamaño de la textura (coordenadas UV)
+        std::vector<SDL_Vertex> vertices;
+    };
+
+    Group& GroupFor(SDL_Texture* texture);
+    static void PushQuad(Group& g, const SDL_FRect& dst, float u0, float v0, float u1, float v1, SDL_FColor color);
+
+    // Grupos en uso: [0, used). Los de detrás conservan su capacidad para el frame siguiente
+    std::vector<Group> groups;
+    size_t used = 0;
+    // Índices de quads (0 1 2, 2 1 3 por cada 4 vértices), compartidos por todos los grupos
+    std::vector<int> indices;
+    // Franjas de cada radio ya usado, relativas al centro
+    std::unordered_map<int, std::vector<SDL_FRect>> circleSpans;
+    int lastDrawCalls = 0;
+};
@@ -13,31 +13,27 @@
 #  include <SDL.h>
 #  include <SDL_render.h>
 #endif
-
-#if defined(__has_include)
-#  if __has_include(<SDL3_image/SDL_image.h>)
-#    include <SDL3_image/SDL_image.h>
-#  elif __has_include(<SDL_image.h>)
-#    include <SDL_image.h>
-#  else
-#    error "SDL_image header not found"
-#  endif
-#else
-#  include <SDL_image.h>
-#endif
 #include <cmath>
 #include <iostream>
+#include "AssetCache.h"
 
 SpriteSheet::SpriteSheet() = default;
 
 SpriteSheet::~SpriteSheet() {
-    if (texture) SDL_DestroyTexture(texture);
+    Unload();
+}
+
+void SpriteSheet::Unload() {
+    AssetCache::Get().ReleaseTexture(texture);
+    texture = nullptr;
 }
 
 bool SpriteSheet::Load(SDL_Renderer* renderer, const std::string& path, int tW, int tH) {
     if (!renderer) return false;
     tileW = tW; tileH = tH;
-    texture = IMG_LoadTexture(renderer, path.c_str());
+    Unload();
+    // Textura compartida de la caché (una por fichero aunque varias hojas la usen)
+    texture = AssetCache::Get().AcquireTexture(renderer, path);
     if (!texture) {
         std::cerr << "[SpriteSheet] failed to load: " << path << " (" << SDL_GetError() << ")\n";
         return false;
@@ -49,8 +45,7 @@ bool SpriteSheet::Load(SDL_Renderer* renderer, const std::string& path, int tW,
     float fw = 0.0f, fh = 0.0f;
     if (!SDL_GetTextureSize(texture, &fw, &fh)) {
         std::cerr << "[SpriteSheet] SDL_GetTextureSize failed: " << SDL_GetError() << "\n";
-        SDL_DestroyTexture(texture);
-        texture = nullptr;
+        Unload();
         return false;
     }
     // Convert float sizes to ints (textures are pixel sizes, floats should be integral)
@@ -59,8 +54,7 @@ bool SpriteSheet::Load(SDL_Renderer* renderer, const std::string& path, int tW,
 
     if (tileW <= 0 || tileH <= 0) {
         std::cerr << "[SpriteSheet] invalid tile size: " << tileW << "x" << tileH << "\n";
-        SDL_DestroyTexture(texture);
-        texture = nullptr;
+        Unload();
         return false;
     }
 
@@ -70,8 +64,7 @@ bool SpriteSheet::Load(SDL_Renderer* renderer, const std::string& path, int tW,
     if (cols <= 0 || rows <= 0) {
         std::cerr << "[SpriteSheet] texture too small for given tile size: tex=" << texW << "x" << texH
                   << " tile=" << tileW << "x" << tileH << "\n";
-        SDL_DestroyTexture(texture);
-        texture = nullptr;
+        Unload();
         return false;
     }
 
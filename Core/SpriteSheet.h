@@ -19,6 +19,8 @@ public:
 
     // Carga la textura desde 'path' usando el renderer. tileW/tileH por defecto 8x8.
     bool Load(SDL_Renderer* renderer, const std::string& path, int tileW = 8, int tileH = 8);
+    // Suelta la textura (referencia en AssetCache); el destructor lo hace solo
+    void Unload();
     SDL_Texture* GetTexture() const { return texture; }
     SDL_Rect GetSrcRect(int index) const;
     int Columns() const { return cols; }
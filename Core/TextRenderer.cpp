@@ -1,4 +1,7 @@
 #include "TextRenderer.h"
+#include "Profiler.h"
+#include "AssetPack.h"
+#include "Log.h"
 #include <iostream>
 
 TextRenderer::TextRenderer() : font(nullptr), initialized(false) {}
@@ -14,8 +17,14 @@ bool TextRenderer::Init() {
         return false;
     }
     
-    // Cargar fuente - intentar desde la carpeta fonts
-    font = TTF_OpenFont("fonts/arial.ttf", 24);
+    // Cargar fuente - del asset pack si está (sin copiar: TTF lee del mapeo), si no de la carpeta fonts
+    SDL_IOStream* io = AssetPack::Get().OpenIO("fonts/arial.ttf");
+    font = io ? TTF_OpenFontIO(io, true, 24) : nullptr;
+    const char* source = "el paquete";
+    if (!font) {
+        font = TTF_OpenFont("fonts/arial.ttf", 24);
+        source = "fichero suelto";
+    }
     if (!font) {
         // Si no está en fonts/, intentar ruta relativa
         font = TTF_OpenFont("arial.ttf", 24);
@@ -25,12 +34,14 @@ bool TextRenderer::Init() {
             return false;
         }
     }
+    LOG_DEBUG(Assets, "fonts/arial.ttf desde " << source);
     
     initialized = true;
     return true;
 }
 
 void TextRenderer::Shutdown() {
+    DestroyAtlas();
     if (font) {
         TTF_CloseFont(font);
         font = nullptr;
@@ -41,9 +52,138 @@ void TextRenderer::Shutdown() {
     }
 }
 
+bool TextRenderer::BuildAtlas(SDL_Renderer* renderer) {
+    const int lineH = TTF_GetFontHeight(font);
+    const int atlasW = 512;
+    const SDL_Color white = {255, 255, 255, 255};
+    glyphs.assign(kLastGlyph - kFirstGlyph + 1, Glyph{});
+    std::vector<SDL_Surface*> surfaces(glyphs.size(), nullptr);
+
+    // Rasterizar cada glifo (como un texto de un carácter: alto de línea, base en el ascent)
+    // y colocarlo en filas de lineH
+    int penX = 0, penY = 0;
+    for (Uint32 ch = kFirstGlyph; ch <= kLastGlyph; ++ch) {
+        if (ch > 0x7E && ch < 0xA0) continue; // controles C1
+        if (!TTF_FontHasGlyph(font, ch)) continue;
+        Glyph& g = glyphs[ch - kFirstGlyph];
+        if (!TTF_GetGlyphMetrics(font, ch, nullptr, nullptr, nullptr, nullptr, &g.advance)) continue;
+        g.present = true;
+        SDL_Surface* s = TTF_RenderGlyph_Solid(font, ch, white);
+        if (!s) continue; // espacios y similares: sólo avance
+        if (penX + s->w > atlasW) {
+            penX = 0;
+            penY += lineH + 1;
+        }
+        g.src = { (float)penX, (float)penY, (float)s->w, (float)s->h };
+        surfaces[ch - kFirstGlyph] = s;
+        penX += s->w + 1;
+    }
+
+    SDL_Surface* sheet = SDL_CreateSurface(atlasW, penY + lineH, SDL_PIXELFORMAT_RGBA32);
+    if (sheet) {
+        SDL_FillSurfaceRect(sheet, nullptr, 0);
+        for (size_t k = 0; k < surfaces.size(); ++k) {
+            SDL_Surface* s = surfaces[k];
+            if (!s) continue;
+            // Copia tal cual: el color key deja transparente el fondo del glifo
+            SDL_SetSurfaceBlendMode(s, SDL_BLENDMODE_NONE);
+            SDL_Rect dst = { (int)glyphs[k].src.x, (int)glyphs[k].src.y, s->w, s->h };
+            SDL_BlitSurface(s, nullptr, sheet, &dst);
+        }
+        atlas = SDL_CreateTextureFromSurface(renderer, sheet);
+        SDL_DestroySurface(sheet);
+    }
+    for (SDL_Surface* s : surfaces) {
+        if (s) SDL_DestroySurface(s);
+    }
+    if (!atlas) {
+        LOG_WARN(Assets, "Error atlas de texto: " << SDL_GetError());
+        glyphs.clear();
+        return false;
+    }
+    SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureScaleMode(atlas, SDL_SCALEMODE_NEAREST);
+    return true;
+}
+
+void TextRenderer::DestroyAtlas() {
+    if (atlas) {
+        SDL_DestroyTexture(atlas);
+        atlas = nullptr;
+    }
+    atlasFailed = false;
+    glyphs.clear();
+    runs.clear();
+}
+
+// Siguiente codepoint UTF-8 de text a partir de i (avanza i); 0xFFFFFFFF si la secuencia no es válida
+static Uint32 NextCodepoint(const std::string& text, size_t& i) {
+    const unsigned char c = (unsigned char)text[i++];
+    if (c < 0x80) return c;
+    int extra = 0;
+    Uint32 cp = 0;
+    if ((c & 0xE0) == 0xC0) { extra = 1; cp = c & 0x1F; }
+    else if ((c & 0xF0) == 0xE0) { extra = 2; cp = c & 0x0F; }
+    else if ((c & 0xF8) == 0xF0) { extra = 3; cp = c & 0x07; }
+    else return 0xFFFFFFFFu;
+    for (; extra > 0; --extra) {
+        if (i >= text.size() || ((unsigned char)text[i] & 0xC0) != 0x80) return 0xFFFFFFFFu;
+        cp = (cp << 6) | ((unsigned char)text[i++] & 0x3F);
+    }
+    return cp;
+}
+
+const TextRenderer::Run& TextRenderer::Layout(const std::string& text) {
+    auto it = runs.find(text);
+    if (it != runs.end()) return it->second;
+    if (runs.size() >= kMaxRuns) runs.clear();
+
+    Run run;
+    float penX = 0.0f;
+    Uint32 prev = 0;
+    for (size_t i = 0; i < text.size();) {
+        const Uint32 cp = NextCodepoint(text, i);
+        if (cp < kFirstGlyph || cp > kLastGlyph || !glyphs[cp - kFirstGlyph].present) {
+            run.inAtlas = false;
+            break;
+        }
+        const Glyph& g = glyphs[cp - kFirstGlyph];
+        int kerning = 0;
+        if (prev && TTF_GetGlyphKerning(font, prev, cp, &kerning)) penX += (float)kerning;
+        if (g.src.w > 0.0f) {
+            run.src.push_back(g.src);
+            run.dst.push_back({ penX, 0.0f, g.src.w, g.src.h });
+        }
+        penX += (float)g.advance;
+        prev = cp;
+    }
+    if (!run.inAtlas) {
+        run.src.clear();
+        run.dst.clear();
+    }
+    return runs.emplace(text, std::move(run)).first->second;
+}
+
 void TextRenderer::RenderText(SDL_Renderer* renderer, const std::string& text, int x, int y, SDL_Color color) {
     if (!font || !initialized) return;
-    
+    PROFILE_SCOPE("text");
+
+    if (!atlas && !atlasFailed) atlasFailed = !BuildAtlas(renderer);
+    const Run* run = atlas ? &Layout(text) : nullptr;
+    if (!run || !run->inAtlas) {
+        RenderTextSlow(renderer, text, x, y, color);
+        return;
+    }
+    for (size_t k = 0; k < run->src.size(); ++k) {
+        SDL_FRect dst = run->dst[k];
+        dst.x += (float)x;
+        dst.y += (float)y;
+        batch.Draw(atlas, &run->src[k], dst, color);
+    }
+    batch.Flush(renderer);
+}
+
+void TextRenderer::RenderTextSlow(SDL_Renderer* renderer, const std::string& text, int x, int y, SDL_Color color) {
     SDL_Surface* surf = TTF_RenderText_Solid(font, text.c_str(), 0, color);
     if (surf) {
         SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
@@ -2,18 +2,51 @@
 #include <SDL3/SDL.h>
 #include <SDL3_ttf/SDL_ttf.h>
 #include <string>
+#include <unordered_map>
+#include <vector>
+#include "SpriteBatch.h"
 
 class TextRenderer {
 public:
     TextRenderer();
     ~TextRenderer();
-    
+
     bool Init();
     void Shutdown();
-    
+
+    // Dibuja con quads del atlas de glifos: sin superficies ni texturas nuevas por frame.
+    // Un texto con caracteres fuera del atlas se rasteriza entero con TTF como antes.
     void RenderText(SDL_Renderer* renderer, const std::string& text, int x, int y, SDL_Color color = {255, 255, 255, 255});
-    
+
 private:
+    // Atlas de la fuente (un tamaño): U+0020..U+007E y U+00A0..U+00FF en blanco, el color
+    // va en los vértices. Se construye la primera vez que hay renderer.
+    static constexpr Uint32 kFirstGlyph = 0x20;
+    static constexpr Uint32 kLastGlyph = 0xFF;
+    struct Glyph {
+        SDL_FRect src = {0, 0, 0, 0}; // en el atlas
+        int advance = 0;
+        bool present = false;
+    };
+    bool BuildAtlas(SDL_Renderer* renderer);
+    void DestroyAtlas();
+
+    // Layout de un texto relativo a su origen (se cachea por cadena: el HUD repite casi
+    // siempre las mismas y sólo cambia al cambiar score/vidas/nivel)
+    struct Run {
+        std::vector<SDL_FRect> src, dst;
+        bool inAtlas = true; // false -> RenderTextSlow
+    };
+    const Run& Layout(const std::string& text);
+    void RenderTextSlow(SDL_Renderer* renderer, const std::string& text, int x, int y, SDL_Color color);
+
     TTF_Font* font;
     bool initialized;
+
+    SDL_Texture* atlas = nullptr;
+    bool atlasFailed = false; // no reintentar cada frame
+    std::vector<Glyph> glyphs; // índice = codepoint - kFirstGlyph
+    static constexpr size_t kMaxRuns = 128; // al pasarse se vacía la caché entera
+    std::unordered_map<std::string, Run> runs;
+    SpriteBatch batch;
 };
@@ -1,8 +1,39 @@
 #include "Game.h"
+#include "SimulationRunner.h"
+#include "Log.h"
+#include "AssetPack.h"
+#include <chrono>
+#include <string>
 
 int main(int argc, char* argv[]) {
+    const auto startup = std::chrono::steady_clock::now();
+    // --log-level trace|debug|info|warn|error|off (el logger es único para todo el proceso)
+    // --pack fichero | --no-pack: paquete de assets (tools/pack); por defecto assets.pack si existe.
+    // Los ficheros sueltos editados después de generarlo tienen prioridad (AssetPack::Open avisa)
+    std::string packPath = "assets.pack";
+    for (int i = 1; i < argc; ++i) {
+        const std::string s(argv[i]);
+        LogLevel level;
+        if (s == "--log-level" && i + 1 < argc && Logger::ParseLevel(argv[i + 1], level))
+            Logger::Get().SetLevel(level);
+        if (s == "--pack" && i + 1 < argc) packPath = argv[i + 1];
+        if (s == "--no-pack") packPath.clear();
+    }
+    // Antes de crear ninguna partida: después sólo se lee (también desde los hilos del batch)
+    const bool packed = !packPath.empty() && AssetPack::Get().Open(packPath);
+
+    // Modo batch: muchas semillas en este proceso, sin ventana, y un único informe JSON
+    BatchOptions batch;
+    if (BatchOptions::FromArgs(argc, argv, batch))
+        return RunBatch(batch);
+
     Game game;
-    if (game.Init())
+    const bool ok = game.Init(GameConfig::FromArgs(argc, argv));
+    // Tiempo de arranque hasta tener la partida lista (comparar con/sin paquete, en frío y en caliente)
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startup).count();
+    LOG_INFO(Game, "Arranque en " << ms << " ms (" << (packed ? packPath : std::string("ficheros sueltos")) << ")");
+    if (ok)
         game.Run();
+    Logger::Get().Flush();
     return 0;
 }
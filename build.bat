@@ -27,7 +27,7 @@ echo #define BUILD_DATE "%DATE%" >> %BUILD_INFO%
 echo #define BUILD_AUTHOR "%AUTHOR%" >> %BUILD_INFO%
 
 REM === COMPILAR ===
-set SRC=Core\main.cpp Core\Game.cpp Core\Player.cpp Core\Enemy.cpp Core\EnemyManager.cpp Core\EnemyFactory.cpp Core\Bullet.cpp Core\Renderer.cpp Core\SpriteSheet.cpp Core\InputManager.cpp Core\CollisionManager.cpp Core\Raycast.cpp Core\ParticleSystem.cpp Core\TextRenderer.cpp Core\AudioManager.cpp Core\AudioManagerMiniaudio.cpp Core\Skyscraper.cpp tools\ai\AIController.cpp
+set SRC=Core\main.cpp Core\Game.cpp Core\Player.cpp Core\Enemy.cpp Core\EnemyManager.cpp Core\EnemyFactory.cpp Core\Bullet.cpp Core\Renderer.cpp Core\SpriteSheet.cpp Core\InputManager.cpp Core\CollisionManager.cpp Core\Raycast.cpp Core\ParticleSystem.cpp Core\TextRenderer.cpp Core\AudioManager.cpp Core\AudioManagerMiniaudio.cpp Core\Skyscraper.cpp Core\SimulationRunner.cpp Core\Replay.cpp Core\Profiler.cpp Core\Log.cpp Core\AllocCounter.cpp Core\SpatialGrid.cpp Core\ShooterIndex.cpp Core\AabbBatch.cpp Core\SpriteBatch.cpp Core\AssetCache.cpp Core\AssetPack.cpp tools\ai\AIController.cpp
 set OUT=SpaceInvaders.exe
 rem Add SDL3_image includes/libs (provided in libs\SDL3_image-3.2.4)
 set INCLUDES=-ICore -Ifonts -Ilibs\SDL3-3.2.18\x86_64-w64-mingw32\include -Ilibs\SDL3_ttf-devel-3.2.2-mingw\x86_64-w64-mingw32\include -Ilibs\SDL3_image-3.2.4\x86_64-w64-mingw32\include -ICore\libs -ICore\libs\nlohmann
@@ -0,0 +1,40 @@
+@echo off
+REM build_sim.bat - Compila SpaceInvadersSim.exe: sólo simulación (headless + autoplay) para tuning masivo
+REM No enlaza SDL3_ttf ni miniaudio y nunca inicializa SDL video. SDL3_image se mantiene
+REM únicamente para decodificar las máscaras de los edificios (mismas colisiones que el juego).
+
+setlocal enabledelayedexpansion
+
+REM === COMPILAR ===
+set SRC=Core\main.cpp Core\Game.cpp Core\Player.cpp Core\Enemy.cpp Core\EnemyManager.cpp Core\EnemyFactory.cpp Core\Bullet.cpp Core\SpriteSheet.cpp Core\InputManager.cpp Core\CollisionManager.cpp Core\Raycast.cpp Core\ParticleSystem.cpp Core\AudioManagerMiniaudio.cpp Core\Skyscraper.cpp Core\SimulationRunner.cpp Core\Replay.cpp Core\Profiler.cpp Core\Log.cpp Core\AllocCounter.cpp Core\SpatialGrid.cpp Core\ShooterIndex.cpp Core\AabbBatch.cpp Core\SpriteBatch.cpp Core\AssetCache.cpp Core\AssetPack.cpp tools\ai\AIController.cpp
+set OUT=SpaceInvadersSim.exe
+set INCLUDES=-ICore -Ilibs\SDL3-3.2.18\x86_64-w64-mingw32\include -Ilibs\SDL3_image-3.2.4\x86_64-w64-mingw32\include -ICore\libs -ICore\libs\nlohmann
+set LIBS=-Llibs\SDL3-3.2.18\x86_64-w64-mingw32\lib -Llibs\SDL3_image-3.2.4\x86_64-w64-mingw32\lib -lSDL3 -lSDL3_image
+
+REM SPACEINVADERS_SIM_ONLY elimina Renderer/TextRenderer/audio de Game y fuerza --headless
+set BUILD_FLAGS=-O2 -DSPACEINVADERS_SIM_ONLY
+if "%1"=="/fast" set BUILD_FLAGS=-O0 -g -DSPACEINVADERS_SIM_ONLY
+
+set PS_SCRIPT=tools\space_build.ps1
+if not exist "%PS_SCRIPT%" (
+        echo ERROR: No se encuentra %PS_SCRIPT%.
+        goto :end
+)
+
+REM Exportar variables para el script (carpeta de objetos separada del build normal)
+set SRC_ENV=%SRC%
+set INCLUDES_ENV=%INCLUDES%
+set LIBS_ENV=%LIBS%
+set OUT_ENV=%OUT%
+set OBJ_DIR_ENV=build_sim
+
+powershell -NoProfile -ExecutionPolicy Bypass -File "%PS_SCRIPT%"
+
+if %ERRORLEVEL%==0 (
+        echo Build de simulacion exitoso: %OUT%
+) else (
+        echo Error en la compilación. Revisa la salida anterior.
+)
+
+:end
+endlocal
@@ -66,8 +66,8 @@ void AIController::Update(float dt) {
 
     // Build enemy rects used for occlusion checks (ignore defense blocks)
     const float eW = enemyW_env, eH = enemyH_env;
-    std::vector<SDL_FRect> enemyRects; enemyRects.reserve(lastObs.enemies.size());
-    std::vector<int> enemyIdx; enemyIdx.reserve(lastObs.enemies.size());
+    enemyRects.clear();
+    enemyIdx.clear();
     for (size_t i = 0; i < lastObs.enemies.size(); ++i) {
         const auto &e = lastObs.enemies[i];
         if (e.hp <= 0) continue;
@@ -76,7 +76,7 @@ void AIController::Update(float dt) {
     }
 
     // 2) PRIORITY 3: Evaluate power-ups: predict fall time and movement time, compute a score
-    int bestPU = -1; float bestScore = 1e9f; std::vector<float> puTimes(lastObs.powerups.size(), 1e9f);
+    int bestPU = -1; float bestScore = 1e9f; puTimes.assign(lastObs.powerups.size(), 1e9f);
     for (size_t i = 0; i < lastObs.powerups.size(); ++i) {
         const auto &pu = lastObs.powerups[i];
         float dx = pu.x - playerXF;
@@ -5,21 +5,21 @@
 #include <iostream>
 #include <cstdlib>
 #include "../../Core/Raycast.h"
+#include "../../Core/GameConfig.h"
 
 namespace tools { namespace ai {
 
 class AIController : public IPlayerController {
 public:
-    AIController(unsigned int seed = 0) {
+    // Load tunable params from environment (used by Optuna tuning script)
+    AIController(unsigned int seed = 0) : AIController(seed, AIParams::FromEnv()) {}
+    // Explicit params: used when several games share one process (SimulationRunner)
+    AIController(unsigned int seed, const AIParams& params) {
         if (seed == 0) seed = (unsigned int)std::chrono::system_clock::now().time_since_epoch().count();
         rng.seed(seed);
-    // Load tunable params from environment (used by Optuna tuning script)
-    const char* ew = std::getenv("AI_ENEMY_W");
-    const char* eh = std::getenv("AI_ENEMY_H");
-    const char* op = std::getenv("AI_OCCLUSION_PENALTY");
-    if (ew) enemyW_env = static_cast<float>(std::atof(ew));
-    if (eh) enemyH_env = static_cast<float>(std::atof(eh));
-    if (op) occlusionPenalty_env = static_cast<float>(std::atof(op));
+        enemyW_env = params.enemyW;
+        enemyH_env = params.enemyH;
+        occlusionPenalty_env = params.occlusionPenalty;
     }
     // Ensure an out-of-line destructor so the vtable is emitted in the .cpp
     virtual ~AIController();
@@ -32,12 +32,25 @@ public:
         lastObs = obs;
         playerX = obs.playerX;
     }
+    // Snapshot: las decisiones de este paso se aplican en el siguiente (Game consulta Wants* antes
+    // de llamar a Update), así que hay que conservarlas. lastObs se rellena en cada Observe.
+    void SaveState(StateWriter& w) const override {
+        w.Put(playerX); w.Put(moveLeft); w.Put(moveRight); w.Put(fire);
+    }
+    bool RestoreState(StateReader& r) override {
+        r.Get(playerX); r.Get(moveLeft); r.Get(moveRight); r.Get(fire);
+        return r.Ok();
+    }
     // Simple observation injection (optional)
     void ObservePlayerX(float x) { playerX = x; }
 private:
     std::mt19937 rng;
     float playerX = 0.0f;
     WorldObservation lastObs;
+    // Buffers de trabajo de Update (se reutilizan entre pasos para no reservar memoria)
+    std::vector<SDL_FRect> enemyRects;
+    std::vector<int> enemyIdx;
+    std::vector<float> puTimes;
     // tunable params (defaults match previous constants)
     float enemyW_env = 44.0f;
     float enemyH_env = 30.0f;
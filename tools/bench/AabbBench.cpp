@@ -0,0 +1,108 @@
+// AabbBench.cpp - microbenchmark del kernel de solapes en lote (Core/AabbBatch) contra el
+// camino escalar: 100, 10k y 1M pares, uno contra muchos y muchos contra muchos.
+// Uso: AabbBench.exe [--seed N]
+#include "AabbBatch.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+struct Scene {
+    std::vector<float> x, y, w, h;
+    std::vector<uint8_t> alive;
+    std::vector<SDL_FRect> rects; // mismo contenido en AoS (como el bucle antiguo con RectCollision)
+
+    Scene(size_t n, std::mt19937& rng) : x(n), y(n), w(n), h(n), alive(n), rects(n) {
+        // Enemigos/balas repartidos por la pantalla de 800x600
+        std::uniform_real_distribution<float> px(0.0f, 800.0f), py(0.0f, 600.0f), size(4.0f, 40.0f);
+        for (size_t i = 0; i < n; ++i) {
+            x[i] = px(rng); y[i] = py(rng); w[i] = size(rng); h[i] = size(rng);
+            alive[i] = (rng() % 8) != 0;
+            rects[i] = { x[i], y[i], w[i], h[i] };
+        }
+    }
+    RectSoA Soa() const { return { x.data(), y.data(), w.data(), h.data(), alive.data(), x.size() }; }
+};
+
+// Mejor de 5 tandas; cada tanda repite fn hasta ~50 ms. Devuelve ns por par
+template <typename Fn>
+static double Measure(size_t pairsPerCall, Fn fn) {
+    using clock = std::chrono::steady_clock;
+    size_t reps = 1;
+    for (;;) {
+        auto t0 = clock::now();
+        for (size_t r = 0; r < reps; ++r) fn();
+        double ms = std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+        if (ms > 50.0 || reps > (1u << 28)) break;
+        reps *= 2;
+    }
+    double best = 1e300;
+    for (int run = 0; run < 5; ++run) {
+        auto t0 = clock::now();
+        for (size_t r = 0; r < reps; ++r) fn();
+        double ns = std::chrono::duration<double, std::nano>(clock::now() - t0).count();
+        if (ns < best) best = ns;
+    }
+    return best / ((double)reps * (double)pairsPerCall);
+}
+
+static volatile size_t g_sink = 0;
+
+int main(int argc, char** argv) {
+    unsigned seed = 12345;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = (unsigned)std::strtoul(argv[++i], nullptr, 10);
+    }
+    std::printf("kernel: %s\n", OverlapKernelName());
+    std::printf("%-10s %10s %14s %14s %14s %8s\n", "mode", "pairs", "aos ns/pair", "scalar ns/pair", "kernel ns/pair", "speedup");
+
+    const size_t sizes[] = { 100, 10000, 1000000 };
+    for (size_t pairs : sizes) {
+        std::mt19937 rng(seed);
+        // Uno contra muchos: un rect contra 'pairs' objetivos
+        {
+            Scene t(pairs, rng);
+            const RectSoA soa = t.Soa();
+            const SDL_FRect probe = { 380.0f, 280.0f, 40.0f, 40.0f };
+            std::vector<uint64_t> mask(OverlapMaskWords(pairs));
+            double aos = Measure(pairs, [&] {
+                size_t hits = 0;
+                for (size_t i = 0; i < pairs; ++i) hits += (t.alive[i] && RectsOverlap(probe, t.rects[i])) ? 1 : 0;
+                g_sink = g_sink + hits;
+            });
+            double scalar = Measure(pairs, [&] { g_sink = g_sink + OverlapMaskScalar(probe, soa, mask.data()); });
+            double kernel = Measure(pairs, [&] { g_sink = g_sink + OverlapMask(probe, soa, mask.data()); });
+            std::printf("%-10s %10zu %14.3f %14.3f %14.3f %7.2fx\n", "1xN", pairs, aos, scalar, kernel, aos / kernel);
+        }
+        // Muchos contra muchos: sqrt(pairs) balas contra sqrt(pairs) objetivos
+        {
+            size_t side = 1;
+            while ((side + 1) * (side + 1) <= pairs) ++side;
+            Scene a(side, rng), t(side, rng);
+            const RectSoA sa = a.Soa(), st = t.Soa();
+            const size_t words = OverlapMaskWords(side);
+            std::vector<uint64_t> masks(side * words);
+            double aos = Measure(side * side, [&] {
+                size_t hits = 0;
+                for (size_t k = 0; k < side; ++k) {
+                    if (!a.alive[k]) continue;
+                    for (size_t i = 0; i < side; ++i) hits += (t.alive[i] && RectsOverlap(a.rects[k], t.rects[i])) ? 1 : 0;
+                }
+                g_sink = g_sink + hits;
+            });
+            double scalar = Measure(side * side, [&] {
+                size_t hits = 0;
+                for (size_t k = 0; k < side; ++k) {
+                    if (!a.alive[k]) continue;
+                    hits += OverlapMaskScalar(a.rects[k], st, &masks[k * words]);
+                }
+                g_sink = g_sink + hits;
+            });
+            double kernel = Measure(side * side, [&] { g_sink = g_sink + OverlapMatrix(sa, st, masks.data()); });
+            std::printf("%-10s %10zu %14.3f %14.3f %14.3f %7.2fx\n", "NxN", side * side, aos, scalar, kernel, aos / kernel);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,323 @@
+// Bench.cpp - microbenchmarks de los caminos calientes de la simulación.
+// Cada fixture monta una escena reproducible (semilla fija, tamaño parametrizable), la
+// restaura sin cronometrar antes de cada iteración y mide sólo la llamada. El resultado
+// sale en JSON para poder compararlo entre builds (tools/bench/compare_bench.py).
+//
+// Uso (desde la raíz del proyecto, necesita Data/ y assets/):
+//   SpaceInvadersBench.exe [--sizes 100,1000,10000] [--iterations N] [--filter texto]
+//                          [--seed N] [--out fichero.json]
+#include "Game.h"
+#include "EnemyManager.h"
+#include "EnemyFactory.h"
+#include "CollisionManager.h"
+#include "ParticleSystem.h"
+#include "Raycast.h"
+#include "Skyscraper.h"
+#include "AabbBatch.h"
+#include "Log.h"
+#include "../../libs/nlohmann/json.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+
+struct BenchOptions {
+    std::vector<size_t> sizes = { 100, 1000, 10000 };
+    int iterations = 200;
+    std::string filter;
+    unsigned seed = 1234;
+    std::string outPath; // vacío = stdout
+};
+
+// Tiempos por iteración (ns) de una fixture con un tamaño
+struct BenchResult {
+    std::string name;
+    size_t size = 0;
+    std::vector<double> ns;
+};
+
+// Ejecuta setup (sin cronometrar) + run (cronometrado) 'iterations' veces
+static BenchResult Measure(const std::string& name, size_t size, int iterations,
+                           const std::function<void(int)>& setup, const std::function<void(int)>& run) {
+    using clock = std::chrono::steady_clock;
+    BenchResult r;
+    r.name = name;
+    r.size = size;
+    r.ns.reserve(iterations);
+    // Una vuelta de calentamiento (cachés, reservas de los vectores de trabajo)
+    setup(0);
+    run(0);
+    for (int it = 0; it < iterations; ++it) {
+        setup(it);
+        auto t0 = clock::now();
+        run(it);
+        r.ns.push_back(std::chrono::duration<double, std::nano>(clock::now() - t0).count());
+    }
+    return r;
+}
+
+static json ToJson(const BenchResult& r) {
+    std::vector<double> v = r.ns;
+    std::sort(v.begin(), v.end());
+    double sum = 0.0;
+    for (double x : v) sum += x;
+    auto pct = [&](double p) { return v[(size_t)(p * (double)(v.size() - 1))]; };
+    json j;
+    j["name"] = r.name;
+    j["size"] = r.size;
+    j["iterations"] = v.size();
+    j["min_ns"] = v.front();
+    j["median_ns"] = pct(0.50);
+    j["p90_ns"] = pct(0.90);
+    j["mean_ns"] = sum / (double)v.size();
+    j["ns_per_item"] = r.size ? pct(0.50) / (double)r.size : pct(0.50);
+    return j;
+}
+
+// Escena de combate: n enemigos en formación en la mitad superior, n/2 balas del jugador
+// subiendo entre ellos y n/4 balas enemigas bajando por encima de los edificios
+struct CombatScene {
+    GameRng rng;
+    EnemyManager enemies{ rng };
+    EnemyArray foes;
+    static constexpr uint32_t BulletCapacity = 8192;
+    BulletArray playerBullets{ BulletCapacity };
+    BulletArray enemyBullets{ BulletCapacity };
+    BulletArray bulletsTemplate{ BulletCapacity };
+    BulletArray enemyBulletsTemplate{ BulletCapacity };
+
+    CombatScene(size_t n, unsigned seed) {
+        rng.Seed(seed);
+        Rng layout(seed, 99);
+        // Rejilla compacta: cuantas más, más pequeñas (caben en 800x360)
+        const size_t cols = std::max<size_t>(1, (size_t)std::sqrt((double)n * 2.0));
+        const size_t rows = (n + cols - 1) / cols;
+        const float cellW = 800.0f / (float)cols, cellH = 360.0f / (float)rows;
+        foes.Reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            const float x = (float)(i % cols) * cellW, y = (float)(i / cols) * cellH;
+            const size_t k = foes.Add(x, y, 1 + layout.Range(3), EnemyColor(), (EnemyType)layout.Range(6), 1.0f, 1, MovePattern::Straight);
+            foes.w[k] = std::max(2.0f, cellW * 0.8f);
+            foes.h[k] = std::max(2.0f, cellH * 0.8f);
+        }
+        const size_t nb = std::min<size_t>(n / 2, bulletsTemplate.Capacity());
+        for (size_t i = 0; i < nb; ++i)
+            bulletsTemplate.Spawn(layout.Float01() * 800.0f, layout.Float01() * 380.0f, -400.0f);
+        const size_t ne = std::min<size_t>(n / 4, enemyBulletsTemplate.Capacity());
+        for (size_t i = 0; i < ne; ++i)
+            enemyBulletsTemplate.Spawn(layout.Float01() * 800.0f, layout.Float01() * 380.0f, 300.0f, 0.0f, false, -1.0f, -1.0f, BulletOwner::Enemy);
+    }
+    void Reset() {
+        enemies.enemies = foes;
+        playerBullets = bulletsTemplate;
+        enemyBullets = enemyBulletsTemplate;
+    }
+};
+
+static void BenchCollisions(const BenchOptions& opt, std::vector<BenchResult>& out, Game& game) {
+    for (size_t n : opt.sizes) {
+        CombatScene scene(n, opt.seed);
+        Player player;
+        player.rect.y = -1000.0f; // fuera del alcance: la partida de soporte no pierde vidas
+        Rng particleRng(opt.seed, 3);
+        ParticleSystem particles(particleRng);
+        CollisionManager collisions(nullptr);
+        out.push_back(Measure("collisions.check", n, opt.iterations,
+            [&](int) { scene.Reset(); particles.Clear(); game.GetPowerUps().Clear(); },
+            [&](int) { collisions.CheckCollisions(player, scene.enemies, scene.playerBullets, scene.enemyBullets, particles, game); }));
+    }
+}
+
+static void BenchEnemies(const BenchOptions& opt, std::vector<BenchResult>& out) {
+    for (size_t n : opt.sizes) {
+        CombatScene scene(n, opt.seed);
+        // Update: los timers avanzan de verdad, así que la media incluye los pasos con
+        // movimiento de formación (cada 0.3 s) igual que en partida
+        out.push_back(Measure("enemies.update", n, opt.iterations,
+            [&](int) { scene.enemies.enemies = scene.foes; },
+            [&](int) { scene.enemies.Update(Game::FixedStep); }));
+
+        scene.Reset();
+        scene.enemies.Update(0.0f); // índice de tiradores al día
+        out.push_back(Measure("enemies.fire", n, opt.iterations,
+            [&](int) { scene.enemyBullets.Clear(); },
+            [&](int) { scene.enemies.FireRandomBullet(scene.enemyBullets, 3); }));
+    }
+}
+
+static void BenchRaycast(const BenchOptions& opt, std::vector<BenchResult>& out) {
+    for (size_t n : opt.sizes) {
+        CombatScene scene(n, opt.seed);
+        std::vector<SDL_FRect> rects;
+        rects.reserve(n);
+        for (size_t i = 0; i < scene.foes.Size(); ++i) rects.push_back(scene.foes.Rect(i));
+        Core::Raycast::HitResult hit;
+        int found = 0;
+        // Rayos verticales desde la altura del jugador, uno por iteración
+        out.push_back(Measure("raycast.rects", n, opt.iterations,
+            [&](int) {},
+            [&](int it) {
+                const float x = 5.0f + (float)((it * 37) % 790);
+                found += Core::Raycast::RaycastRects({ x, 560.0f }, { x, 0.0f }, rects, hit) >= 0 ? 1 : 0;
+            }));
+    }
+}
+
+static void BenchSkyscraper(const BenchOptions& opt, std::vector<BenchResult>& out) {
+    // n = impactos / consultas por iteración sobre los 6 edificios de siempre
+    for (size_t n : opt.sizes) {
+        GameRng rng;
+        rng.Seed(opt.seed);
+        EnemyManager enemies(rng);
+        std::vector<Skyscraper>& blocks = enemies.defenseBlocks;
+        Rng pick(opt.seed, 7);
+        std::vector<SDL_FPoint> points(n);
+        std::vector<size_t> targets(n);
+        for (size_t i = 0; i < n; ++i) {
+            targets[i] = (size_t)pick.Range((int)blocks.size());
+            const SDL_FRect& r = blocks[targets[i]].rect;
+            points[i] = { r.x + pick.Float01() * r.w, r.y + pick.Float01() * r.h };
+        }
+        out.push_back(Measure("skyscraper.hit", n, opt.iterations,
+            [&](int) { for (auto& b : blocks) b.Restore(nullptr); },
+            [&](int) { for (size_t i = 0; i < n; ++i) blocks[targets[i]].TakeBulletHit(points[i].x, points[i].y, 18); }));
+
+        // Consultas sobre edificios a medio destruir
+        for (auto& b : blocks) b.Restore(nullptr);
+        for (size_t i = 0; i < n / 4; ++i) blocks[targets[i]].TakeBulletHit(points[i].x, points[i].y, 18);
+        int opaque = 0;
+        out.push_back(Measure("skyscraper.opaque", n, opt.iterations,
+            [&](int) {},
+            [&](int) { for (size_t i = 0; i < n; ++i) opaque += blocks[targets[i]].IsOpaqueAtWorld(points[i].x, points[i].y) ? 1 : 0; }));
+    }
+}
+
+static void BenchParticles(const BenchOptions& opt, std::vector<BenchResult>& out) {
+    // n = partículas vivas al empezar el paso
+    for (size_t n : opt.sizes) {
+        Rng rng(opt.seed, 3);
+        ParticleSystem particles(rng);
+        out.push_back(Measure("particles.update", n, opt.iterations,
+            [&](int) {
+                particles.Clear();
+                rng.Seed(opt.seed, 3);
+                for (size_t made = 0; made < n; made += 15) particles.CreateExplosion(400.0f, 300.0f, 15);
+            },
+            [&](int) { particles.Update(Game::FixedStep); }));
+    }
+}
+
+static void BenchFactory(const BenchOptions& opt, std::vector<BenchResult>& out) {
+    // Sin tamaño de escena: parsea Data/levels.json y crea un nivel (van rotando)
+    size_t created = 0;
+    BenchResult r = Measure("factory.levels", 1, std::max(1, opt.iterations / 10),
+        [&](int) {},
+        [&](int it) { created += EnemyFactory::CreateEnemiesFromLevels("Data/levels.json", it % 5).Size(); });
+    out.push_back(r);
+}
+
+static bool ParseArgs(int argc, char** argv, BenchOptions& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (a == "--sizes" && hasValue) {
+            opt.sizes.clear();
+            std::string list = argv[++i];
+            size_t pos = 0;
+            while (pos < list.size()) {
+                size_t comma = list.find(',', pos);
+                if (comma == std::string::npos) comma = list.size();
+                unsigned long v = std::strtoul(list.substr(pos, comma - pos).c_str(), nullptr, 10);
+                if (v > 0) opt.sizes.push_back((size_t)v);
+                pos = comma + 1;
+            }
+            if (opt.sizes.empty()) return false;
+        } else if (a == "--iterations" && hasValue) {
+            opt.iterations = std::max(1, std::atoi(argv[++i]));
+        } else if (a == "--filter" && hasValue) {
+            opt.filter = argv[++i];
+        } else if (a == "--seed" && hasValue) {
+            opt.seed = (unsigned)std::strtoul(argv[++i], nullptr, 10);
+        } else if (a == "--out" && hasValue) {
+            opt.outPath = argv[++i];
+        } else {
+            std::cerr << "Uso: " << argv[0] << " [--sizes 100,1000,10000] [--iterations N] [--filter texto] [--seed N] [--out fichero.json]" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    BenchOptions opt;
+    if (!ParseArgs(argc, argv, opt)) return 1;
+    // Que el log de carga de niveles no se mezcle con el JSON
+    Logger::Get().SetLevel(LogLevel::Warn);
+
+    // Partida de soporte para CheckCollisions (puntos, drops, powerups); nunca avanza
+    GameConfig cfg;
+    cfg.headless = true;
+    cfg.autoplay = true;
+    cfg.seed = opt.seed;
+    cfg.writeHistory = false;
+    // Cada drop de collisions.check debe caber: como mucho uno por bala del jugador
+    cfg.powerUpCapacity = CombatScene::BulletCapacity;
+    Game game;
+    if (!game.Init(cfg)) {
+        std::cerr << "Game::Init failed (ejecutar desde la raíz del proyecto)" << std::endl;
+        return 1;
+    }
+    // Sin log durante las mediciones: formatear y encolar avisos no debe contar en los tiempos
+    Logger::Get().SetLevel(LogLevel::Off);
+
+    struct Fixture { const char* name; std::function<void(std::vector<BenchResult>&)> run; };
+    const Fixture fixtures[] = {
+        { "collisions", [&](std::vector<BenchResult>& out) { BenchCollisions(opt, out, game); } },
+        { "enemies",    [&](std::vector<BenchResult>& out) { BenchEnemies(opt, out); } },
+        { "raycast",    [&](std::vector<BenchResult>& out) { BenchRaycast(opt, out); } },
+        { "skyscraper", [&](std::vector<BenchResult>& out) { BenchSkyscraper(opt, out); } },
+        { "particles",  [&](std::vector<BenchResult>& out) { BenchParticles(opt, out); } },
+        { "factory",    [&](std::vector<BenchResult>& out) { BenchFactory(opt, out); } },
+    };
+
+    std::vector<BenchResult> results;
+    for (const Fixture& f : fixtures) {
+        if (!opt.filter.empty() && std::string(f.name).find(opt.filter) == std::string::npos) continue;
+        std::cerr << "[Bench] " << f.name << std::endl;
+        f.run(results);
+    }
+    if (game.GetPowerUps().Rejected() > 0)
+        std::cerr << "[Bench] aviso: " << game.GetPowerUps().Rejected() << " drops perdidos por pool lleno" << std::endl;
+    Logger::Get().Flush();
+
+    json report;
+    report["seed"] = opt.seed;
+    report["iterations"] = opt.iterations;
+    report["sizes"] = opt.sizes;
+    report["aabb_kernel"] = OverlapKernelName();
+#if defined(__VERSION__)
+    report["compiler"] = __VERSION__;
+#endif
+    report["results"] = json::array();
+    for (const BenchResult& r : results) report["results"].push_back(ToJson(r));
+
+    if (opt.outPath.empty()) {
+        std::cout << report.dump(2) << std::endl;
+    } else {
+        std::ofstream f(opt.outPath);
+        if (!f) {
+            std::cerr << "No se puede escribir " << opt.outPath << std::endl;
+            return 1;
+        }
+        f << report.dump(2) << std::endl;
+        std::cerr << "[Bench] Resultados en " << opt.outPath << std::endl;
+    }
+    return 0;
+}
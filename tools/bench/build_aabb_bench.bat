@@ -0,0 +1,27 @@
+@echo off
+rem build_aabb_bench.bat - compila AabbBench.exe (microbenchmark del kernel de solapes)
+rem Uso: build_aabb_bench.bat [/avx2]   (/avx2 compila el kernel AVX2 en lugar del SSE2)
+setlocal
+
+set BASE=%~dp0..\..
+set SRC=%~dp0AabbBench.cpp Core\AabbBatch.cpp
+set OUT=AabbBench.exe
+
+set INCLUDES=-ICore -Ilibs\SDL3-3.2.18\x86_64-w64-mingw32\include
+set FLAGS=-O2
+if "%1"=="/avx2" set FLAGS=-O2 -mavx2
+
+echo Compiling AabbBench...
+pushd %BASE%
+"C:\mingw64\bin\g++.exe" -std=c++17 %FLAGS% %INCLUDES% %SRC% -o "%OUT%"
+if errorlevel 1 (
+    echo Compilation failed.
+    popd
+    endlocal
+    exit /b 1
+)
+
+echo Build succeeded: %CD%\%OUT%
+copy /Y "%OUT%" %~dp0
+popd
+endlocal
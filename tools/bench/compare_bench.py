@@ -0,0 +1,66 @@
+"""Compare two SpaceInvadersBench JSON reports.
+
+Usage: python tools/bench/compare_bench.py base.json new.json [--threshold 5]
+
+Matches results by (name, size) and prints the median time of both runs and the
+relative change. Changes above the threshold (percent) are flagged as faster/slower.
+Exits with 1 if any benchmark got slower than the threshold, so it can gate a script.
+"""
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path, 'r', encoding='utf-8') as fh:
+        j = json.load(fh)
+    results = {}
+    for r in j.get('results', []):
+        results[(r['name'], r['size'])] = r
+    return j, results
+
+
+def fmt_ns(ns):
+    if ns >= 1e6:
+        return f'{ns / 1e6:.2f} ms'
+    if ns >= 1e3:
+        return f'{ns / 1e3:.2f} us'
+    return f'{ns:.0f} ns'
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Compare two benchmark reports')
+    ap.add_argument('base')
+    ap.add_argument('new')
+    ap.add_argument('--threshold', type=float, default=5.0, help='percent change considered significant')
+    args = ap.parse_args()
+
+    base_j, base = load(args.base)
+    new_j, new = load(args.new)
+    if base_j.get('aabb_kernel') != new_j.get('aabb_kernel'):
+        print(f"NOTE: aabb kernel differs ({base_j.get('aabb_kernel')} -> {new_j.get('aabb_kernel')})")
+
+    slower = 0
+    print(f"{'benchmark':<22} {'size':>7} {'base':>12} {'new':>12} {'change':>9}")
+    for key in sorted(set(base) | set(new)):
+        name, size = key
+        if key not in base or key not in new:
+            where = 'new' if key in new else 'base'
+            print(f'{name:<22} {size:>7} (only in {where})')
+            continue
+        b = base[key]['median_ns']
+        n = new[key]['median_ns']
+        change = (n - b) / b * 100.0 if b > 0 else 0.0
+        mark = ''
+        if change > args.threshold:
+            mark = '  slower'
+            slower += 1
+        elif change < -args.threshold:
+            mark = '  faster'
+        print(f'{name:<22} {size:>7} {fmt_ns(b):>12} {fmt_ns(n):>12} {change:>+8.1f}%{mark}')
+
+    return 1 if slower else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,234 @@
+// AssetPacker.cpp - genera assets.pack (Core/AssetPack.h) con los ficheros de un manifiesto
+// (por defecto tools/pack/assets.txt: lo que carga el juego, una ruta por línea).
+// Cada fichero se guarda ya convertido según su extensión:
+//  - Imágenes (.png .jpg .bmp): decodificadas con SDL_image y guardadas en RGBA32 crudo
+//  - Sonidos (.wav): decodificados con miniaudio a PCM float32 (canales y frecuencia originales)
+//  - Niveles (.json): MessagePack
+//  - Resto (fuentes .ttf): tal cual
+// Las rutas del índice son las mismas que usa el juego ("assets/base.png"), así que cualquier
+// asset que falte en el paquete se sigue leyendo suelto.
+//
+// Uso (desde la raíz del proyecto):
+//   AssetPacker.exe [--manifest tools/pack/assets.txt] [--out assets.pack]   empaquetar
+//   AssetPacker.exe --list [assets.pack]                                      listar el índice
+#define MA_NO_DEVICE_IO
+#define MINIAUDIO_IMPLEMENTATION
+#include "miniaudio.h"
+#include "AssetPack.h"
+#include "Log.h"
+#include "../../libs/nlohmann/json.hpp"
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+using Format = AssetPackFormat;
+
+struct PackItem {
+    Format::Entry entry;
+    std::vector<uint8_t> data;
+};
+
+static std::string Lower(std::string s) {
+    for (char& c : s) c = (char)std::tolower((unsigned char)c);
+    return s;
+}
+
+static bool ReadFile(const fs::path& p, std::vector<uint8_t>& out) {
+    std::ifstream in(p, std::ios::binary);
+    if (!in) return false;
+    out.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+static bool PackImage(const fs::path& p, PackItem& item) {
+    SDL_Surface* loaded = IMG_Load(p.string().c_str());
+    if (!loaded) {
+        std::cerr << "  IMG_Load failed: " << p.string() << " (" << SDL_GetError() << ")\n";
+        return false;
+    }
+    SDL_Surface* rgba = SDL_ConvertSurface(loaded, SDL_PIXELFORMAT_RGBA32);
+    SDL_DestroySurface(loaded);
+    if (!rgba) return false;
+    // Filas compactas (pitch = w * 4), que es lo que espera AssetCache
+    const size_t row = (size_t)rgba->w * 4;
+    item.data.resize(row * rgba->h);
+    for (int y = 0; y < rgba->h; ++y) {
+        memcpy(&item.data[row * y], (const uint8_t*)rgba->pixels + (size_t)y * rgba->pitch, row);
+    }
+    item.entry.kind = Format::Kind::Image;
+    item.entry.a = (uint32_t)rgba->w;
+    item.entry.b = (uint32_t)rgba->h;
+    SDL_DestroySurface(rgba);
+    return true;
+}
+
+static bool PackSound(const fs::path& p, PackItem& item) {
+    // Canales y frecuencia del fichero; sólo se fija el formato de muestra
+    ma_decoder_config cfg = ma_decoder_config_init(ma_format_f32, 0, 0);
+    ma_uint64 frames = 0;
+    void* pcm = nullptr;
+    if (ma_decode_file(p.string().c_str(), &cfg, &frames, &pcm) != MA_SUCCESS) {
+        std::cerr << "  decode failed: " << p.string() << "\n";
+        return false;
+    }
+    const size_t bytes = (size_t)frames * cfg.channels * sizeof(float);
+    item.data.assign((const uint8_t*)pcm, (const uint8_t*)pcm + bytes);
+    ma_free(pcm, nullptr);
+    item.entry.kind = Format::Kind::Sound;
+    item.entry.a = cfg.channels;
+    item.entry.b = cfg.sampleRate;
+    return true;
+}
+
+static bool PackLevels(const fs::path& p, PackItem& item) {
+    std::ifstream in(p);
+    json data = json::parse(in, nullptr, false);
+    if (data.is_discarded()) {
+        std::cerr << "  invalid JSON: " << p.string() << "\n";
+        return false;
+    }
+    item.data = json::to_msgpack(data);
+    item.entry.kind = Format::Kind::Levels;
+    return true;
+}
+
+static bool PackRaw(const fs::path& p, PackItem& item) {
+    item.entry.kind = Format::Kind::Raw;
+    return ReadFile(p, item.data);
+}
+
+// Ficheros del manifiesto y cómo empaquetar cada uno (Kind según la extensión)
+static bool Collect(const std::string& manifest, std::vector<std::pair<fs::path, Format::Kind>>& files) {
+    std::ifstream in(manifest);
+    if (!in) {
+        std::cerr << "Cannot read manifest " << manifest << "\n";
+        return false;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        line.erase(0, line.find_first_not_of(" \t"));
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        if (line.empty() || line[0] == '#') continue;
+        const fs::path p(line);
+        const std::string ext = Lower(p.extension().string());
+        Format::Kind kind = Format::Kind::Raw;
+        if (ext == ".png" || ext == ".jpg" || ext == ".bmp") kind = Format::Kind::Image;
+        else if (ext == ".wav") kind = Format::Kind::Sound;
+        else if (ext == ".json") kind = Format::Kind::Levels;
+        files.push_back({ p, kind });
+    }
+    return true;
+}
+
+static int Pack(const std::string& manifest, const std::string& outPath) {
+    std::vector<std::pair<fs::path, Format::Kind>> files;
+    if (!Collect(manifest, files)) return 1;
+    std::vector<PackItem> items;
+    for (const auto& f : files) {
+        const std::string path = f.first.generic_string();
+        if (path.size() >= Format::kPathMax) {
+            std::cerr << "  path too long, skipped: " << path << "\n";
+            continue;
+        }
+        PackItem item;
+        memset(&item.entry, 0, sizeof(item.entry));
+        memcpy(item.entry.path, path.c_str(), path.size());
+        bool ok = false;
+        switch (f.second) {
+            case Format::Kind::Image: ok = PackImage(f.first, item); break;
+            case Format::Kind::Sound: ok = PackSound(f.first, item); break;
+            case Format::Kind::Levels: ok = PackLevels(f.first, item); break;
+            case Format::Kind::Raw: ok = PackRaw(f.first, item); break;
+        }
+        if (ok) items.push_back(std::move(item));
+        else std::cerr << "  skipped: " << path << "\n";
+    }
+    // Orden estable: el mismo árbol produce el mismo fichero
+    std::sort(items.begin(), items.end(), [](const PackItem& x, const PackItem& y) {
+        return strcmp(x.entry.path, y.entry.path) < 0;
+    });
+
+    auto align = [](uint64_t v) { return (v + Format::kAlign - 1) & ~(Format::kAlign - 1); };
+    Format::Header header;
+    memcpy(header.magic, Format::kMagic, sizeof(header.magic));
+    header.version = Format::kVersion;
+    header.entryCount = (uint32_t)items.size();
+    uint64_t offset = align(sizeof(header) + sizeof(Format::Entry) * items.size());
+    for (PackItem& item : items) {
+        item.entry.offset = offset;
+        item.entry.size = item.data.size();
+        offset = align(offset + item.data.size());
+    }
+
+    std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Cannot write " << outPath << "\n";
+        return 1;
+    }
+    out.write((const char*)&header, sizeof(header));
+    for (const PackItem& item : items) out.write((const char*)&item.entry, sizeof(item.entry));
+    static const char zeros[Format::kAlign] = {};
+    for (const PackItem& item : items) {
+        const uint64_t pos = (uint64_t)out.tellp();
+        out.write(zeros, (std::streamsize)(item.entry.offset - pos));
+        out.write((const char*)item.data.data(), (std::streamsize)item.data.size());
+    }
+    out.close();
+    if (!out) {
+        std::cerr << "Write failed: " << outPath << "\n";
+        return 1;
+    }
+    std::cout << "Packed " << items.size() << " assets into " << outPath << " (" << (offset >> 10) << " KB)\n";
+    return 0;
+}
+
+static int List(const std::string& packPath) {
+    std::vector<uint8_t> bytes;
+    if (!ReadFile(packPath, bytes) || bytes.size() < sizeof(Format::Header)) {
+        std::cerr << "Cannot read " << packPath << "\n";
+        return 1;
+    }
+    Format::Header header;
+    memcpy(&header, bytes.data(), sizeof(header));
+    if (memcmp(header.magic, Format::kMagic, sizeof(header.magic)) != 0 ||
+        bytes.size() < sizeof(header) + (size_t)header.entryCount * sizeof(Format::Entry)) {
+        std::cerr << "Not an asset pack: " << packPath << "\n";
+        return 1;
+    }
+    static const char* kinds[] = { "raw", "image", "sound", "levels" };
+    for (uint32_t i = 0; i < header.entryCount; ++i) {
+        Format::Entry e;
+        memcpy(&e, bytes.data() + sizeof(header) + i * sizeof(e), sizeof(e));
+        const uint32_t k = (uint32_t)e.kind;
+        std::printf("%-7s %10llu  %5u %6u  %s\n", k < 4 ? kinds[k] : "?", (unsigned long long)e.size, e.a, e.b, e.path);
+    }
+    // Comprobar además que el reader del juego lo acepta
+    return AssetPack::Get().Open(packPath) ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    std::string outPath = "assets.pack";
+    std::string manifest = "tools/pack/assets.txt";
+    for (int i = 1; i < argc; ++i) {
+        const std::string s(argv[i]);
+        if (s == "--list") return List(i + 1 < argc ? argv[i + 1] : outPath);
+        if (s == "--out" && i + 1 < argc) outPath = argv[++i];
+        if (s == "--manifest" && i + 1 < argc) manifest = argv[++i];
+    }
+    const auto t0 = std::chrono::steady_clock::now();
+    const int rc = Pack(manifest, outPath);
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    std::cout << "Done in " << ms << " ms\n";
+    Logger::Get().Flush();
+    return rc;
+}
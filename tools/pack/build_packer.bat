@@ -0,0 +1,34 @@
+@echo off
+rem build_packer.bat - compila AssetPacker.exe y genera assets.pack en la raíz del proyecto
+rem Uso: build_packer.bat [/nopack]   (/nopack sólo compila, sin ejecutar el packer)
+setlocal
+
+set BASE=%~dp0..\..
+set SRC=tools\pack\AssetPacker.cpp Core\AssetPack.cpp Core\Log.cpp
+set OUT=AssetPacker.exe
+
+set INCLUDES=-ICore -Ilibs\SDL3-3.2.18\x86_64-w64-mingw32\include -Ilibs\SDL3_image-3.2.4\x86_64-w64-mingw32\include
+set LIBS=-Llibs\SDL3-3.2.18\x86_64-w64-mingw32\lib -Llibs\SDL3_image-3.2.4\x86_64-w64-mingw32\lib -lSDL3 -lSDL3_image
+
+echo Compiling AssetPacker...
+pushd %BASE%
+"C:\mingw64\bin\g++.exe" -std=c++17 -O2 %INCLUDES% %SRC% -o "%OUT%" %LIBS%
+if errorlevel 1 (
+    echo Compilation failed.
+    popd
+    endlocal
+    exit /b 1
+)
+
+echo Build succeeded: %CD%\%OUT%
+if not "%1"=="/nopack" (
+    "%OUT%" --out assets.pack
+    if errorlevel 1 (
+        echo Packing failed.
+        popd
+        endlocal
+        exit /b 1
+    )
+)
+popd
+endlocal
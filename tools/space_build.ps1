@@ -10,6 +10,9 @@ if (-not $buildFlags) { $buildFlags = '-O2' }
 $includes = $env:INCLUDES_ENV
 $libs = $env:LIBS_ENV
 $out = $env:OUT_ENV
+# Carpeta de objetos: cada variante de build (juego, simulación) usa la suya porque el link toma todos los .o
+$objDir = $env:OBJ_DIR_ENV
+if (-not $objDir) { $objDir = 'build' }
 
 Write-Host "[BUILD] Working dir: $(Get-Location)"
 Write-Host "[BUILD] Compiler: $compiler"
@@ -19,7 +22,7 @@ if (!(Test-Path $compiler)) {
     exit 2
 }
 
-if (!(Test-Path 'build')) { New-Item -ItemType Directory -Path 'build' | Out-Null }
+if (!(Test-Path $objDir)) { New-Item -ItemType Directory -Path $objDir | Out-Null }
 
 $total = $srcList.Count
 $times = @()
@@ -33,7 +36,7 @@ for ($i=0; $i -lt $total; $i++) {
         exit 3
     }
     $name = [System.IO.Path]::GetFileNameWithoutExtension($src)
-    $obj = Join-Path 'build' ($name + '.o')
+    $obj = Join-Path $objDir ($name + '.o')
     Write-Host "[BUILD] Compiling ($([int]($i+1))/$total): $src"
     $t0 = Get-Date
     $argList = @('-std=c++17') + ($buildFlags -split ' ') + @('-c', $src) + (($includes -split ' ') | Where-Object { $_ -ne '' }) + @('-o', $obj)
@@ -50,7 +53,7 @@ for ($i=0; $i -lt $total; $i++) {
 }
 
 Write-Host '[BUILD] Linking...'
- $objsList = (Get-ChildItem -Path build -Filter *.o | ForEach-Object { $_.FullName })
+ $objsList = (Get-ChildItem -Path $objDir -Filter *.o | ForEach-Object { $_.FullName })
  $argList = @('-std=c++17') + ($buildFlags -split ' ') + $objsList + (($libs -split ' ') | Where-Object { $_ -ne '' }) + @('-o', $out)
  Write-Host "[BUILD] LINK CMD: $compiler $($argList -join ' ')"
  & $compiler @argList
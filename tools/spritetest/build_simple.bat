@@ -8,7 +8,7 @@ set BASE=%~dp0..\..
 set OUT_DIR=%BASE%\
 
 rem Usar exactamente las mismas configuraciones que build.bat
-set SRC="%~dp0SpriteTestSimple.cpp" "%BASE%\Core\Renderer.cpp" "%BASE%\Core\SpriteSheet.cpp" "%BASE%\Core\TextRenderer.cpp"
+set SRC="%~dp0SpriteTestSimple.cpp" "%BASE%\Core\Renderer.cpp" "%BASE%\Core\SpriteSheet.cpp" "%BASE%\Core\TextRenderer.cpp" "%BASE%\Core\AssetCache.cpp" "%BASE%\Core\AssetPack.cpp" "%BASE%\Core\Log.cpp" "%BASE%\Core\SpriteBatch.cpp" "%BASE%\Core\Profiler.cpp"
 set INCLUDES=-ICore -Ifonts -Ilibs\SDL3-3.2.18\x86_64-w64-mingw32\include -Ilibs\SDL3_ttf-devel-3.2.2-mingw\x86_64-w64-mingw32\include -Ilibs\SDL3_image-3.2.4\x86_64-w64-mingw32\include -ICore\libs -ICore\libs\nlohmann
 set LIBS=-Llibs\SDL3-3.2.18\x86_64-w64-mingw32\lib -Llibs\SDL3_ttf-devel-3.2.2-mingw\x86_64-w64-mingw32\lib -Llibs\SDL3_image-3.2.4\x86_64-w64-mingw32\lib -lSDL3 -lSDL3_ttf -lSDL3_image
 
@@ -21,8 +21,9 @@ popd >nul 2>&1
 rem Place the final executable in the project root (same folder as SpaceInvaders.exe)
 set OUT_DIR=%BASE%\
 
-rem Source files to compile for the SpriteTest PoC (include Renderer.cpp because SpriteTest uses Renderer)
-set SRCS="%BASE%\Core\SpriteSheet.cpp" "%BASE%\Core\Renderer.cpp" "%~dp0SpriteTest.cpp"
+rem Source files to compile for the SpriteTest PoC (include Renderer.cpp because SpriteTest uses Renderer,
+rem plus the asset cache, sprite batch and logger it depends on)
+set SRCS="%BASE%\Core\SpriteSheet.cpp" "%BASE%\Core\Renderer.cpp" "%BASE%\Core\AssetCache.cpp" "%BASE%\Core\AssetPack.cpp" "%BASE%\Core\Log.cpp" "%BASE%\Core\SpriteBatch.cpp" "%BASE%\Core\Profiler.cpp" "%~dp0SpriteTest.cpp"
 
 set SDL3_INC=%BASE%\libs\SDL3-3.2.18\x86_64-w64-mingw32\include
 set SDL3_LIB=%BASE%\libs\SDL3-3.2.18\x86_64-w64-mingw32\lib
@@ -72,12 +72,61 @@ def run_game_with_params(params, seed, timeout=180):
     return data
 
 
-def objective(trial, seeds_per_trial, timeout):
+def run_batch_with_params(params, first_seed, count, threads, timeout, max_sim_seconds):
+    """Evaluate `count` consecutive seeds in a single process (--batch-seeds) and return the report.
+
+    `timeout` is the wall-clock budget per seed (the whole batch gets timeout * count);
+    `max_sim_seconds` caps each game in simulated time. Returns None if the batch fails."""
+    env = os.environ.copy()
+    env["AI_OCCLUSION_PENALTY"] = str(params["occlusion_penalty"])
+    env["AI_ENEMY_W"] = str(params["enemy_w"])
+    env["AI_ENEMY_H"] = str(params["enemy_h"])
+    last_seed = first_seed + count - 1
+    report_path = LOGS_DIR / f"batch_{first_seed}-{last_seed}.json"
+    # A stale report from an earlier run must not be read back as this batch's result
+    if report_path.exists():
+        report_path.unlink()
+    cmd = [str(GAME_EXE), "--batch-seeds", f"{first_seed}-{last_seed}", "--threads", str(threads),
+           "--max-sim-seconds", str(max_sim_seconds), "--out", str(report_path)]
+    try:
+        proc = subprocess.run(cmd, env=env, capture_output=True, text=True, timeout=timeout * count, cwd=str(ROOT))
+    except subprocess.TimeoutExpired:
+        print(f"[tune] Batch {first_seed}-{last_seed} timed out after {timeout * count}s")
+        return None
+    if proc.returncode != 0:
+        print(f"[tune] Batch {first_seed}-{last_seed} exited with code {proc.returncode}")
+        tail = proc.stderr.strip().splitlines()[-5:]
+        for line in tail:
+            print(f"[tune]   {line}")
+        return None
+    try:
+        return json.loads(report_path.read_text())
+    except Exception as e:
+        print(f"[tune] Batch {first_seed}-{last_seed} report unreadable: {e}")
+        return None
+
+
+class BatchFailed(RuntimeError):
+    pass
+
+
+def objective(trial, seeds_per_trial, timeout, max_sim_seconds, threads=0):
     params = {
         "occlusion_penalty": trial.suggest_float("occlusion_penalty", 0.0, 20.0),
         "enemy_w": trial.suggest_float("enemy_w", 20.0, 80.0),
         "enemy_h": trial.suggest_float("enemy_h", 15.0, 50.0),
     }
+    if threads is not None:
+        # One process per trial: every seed runs in-process across the thread pool. No silent
+        # fallback to the per-process loop: a failed batch fails the trial (use --per-process
+        # explicitly for the legacy mode)
+        first = random.randint(1, 1000000)
+        report = run_batch_with_params(params, first, seeds_per_trial, threads, timeout, max_sim_seconds)
+        if report is None:
+            raise BatchFailed(f"batch {first}-{first + seeds_per_trial - 1} failed")
+        avg = report["stats"]["objective"]["mean"]
+        print(f"[tune] trial {trial.number} seeds {first}-{first + seeds_per_trial - 1} avg_obj={avg} ({report['wall_seconds']:.2f}s)")
+        return avg
     seeds = [random.randint(1, 1000000) for _ in range(seeds_per_trial)]
     vals = []
     for s in seeds:
@@ -97,7 +146,10 @@ def parse_args():
     p = argparse.ArgumentParser()
     p.add_argument("--trials", type=int, default=int(os.environ.get("N_TRIALS", 30)))
     p.add_argument("--seeds", type=int, default=int(os.environ.get("SEEDS_PER_TRIAL", 3)))
-    p.add_argument("--timeout", type=int, default=int(os.environ.get("RUN_TIMEOUT", 180)))
+    p.add_argument("--timeout", type=int, default=int(os.environ.get("RUN_TIMEOUT", 180)), help="wall-clock seconds per seed")
+    p.add_argument("--max-sim-seconds", type=float, default=float(os.environ.get("MAX_SIM_SECONDS", 600)), help="simulated-time cap per game in --batch-seeds mode")
+    p.add_argument("--threads", type=int, default=int(os.environ.get("BATCH_THREADS", 0)), help="threads for --batch-seeds (0 = all cores)")
+    p.add_argument("--per-process", action="store_true", help="legacy mode: one SpaceInvaders.exe process per seed")
     p.add_argument("--study-name", type=str, default=os.environ.get("OPTUNA_STUDY_NAME", "space_inv"))
     p.add_argument("--storage", type=str, default=os.environ.get("OPTUNA_STORAGE", "sqlite:///Data/optuna.db"))
     return p.parse_args()
@@ -124,7 +176,10 @@ if __name__ == "__main__":
 
     study = optuna.create_study(storage=STORAGE, study_name=STUDY_NAME, load_if_exists=True, direction="minimize")
     try:
-        study.optimize(lambda t: objective(t, SEEDS_PER_TRIAL, TIMEOUT), n_trials=N_TRIALS, n_jobs=1)
+        threads = None if args.per_process else args.threads
+        # A failed batch marks that trial as failed and the study moves on
+        study.optimize(lambda t: objective(t, SEEDS_PER_TRIAL, TIMEOUT, args.max_sim_seconds, threads),
+                       n_trials=N_TRIALS, n_jobs=1, catch=(BatchFailed,))
     except KeyboardInterrupt:
         print("[tune] interrupted by user")
 